@@ -0,0 +1,242 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CommonInputLatencyTracker.h"
+#include "CommonInputPrivatePCH.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+bool GCommonInputTraceLatency = false;
+static FAutoConsoleVariableRef CVarCommonInputTraceLatency(
+	TEXT("CommonInput.TraceInputLatency"),
+	GCommonInputTraceLatency,
+	TEXT("If true, the latency between key presses and the UI actions they trigger is measured. See CommonInput.DumpInputLatency."),
+	ECVF_Default
+);
+
+namespace CommonInputLatency
+{
+	/** Samples kept per action, beyond which the oldest are overwritten */
+	static const int32 MaxSamplesPerAction = 512;
+
+	struct FPressStamp
+	{
+		double Time = 0.;
+		uint64 Frame = 0;
+	};
+
+	struct FSample
+	{
+		float RoutedMs = 0.f;
+		float FiredMs = 0.f;
+		float FrameEndMs = 0.f;
+		int32 FrameEndFrames = 0;
+	};
+
+	struct FActionSamples
+	{
+		TArray<FSample> Samples;
+		int32 NextSampleIndex = 0;
+
+		void Add(const FSample& Sample)
+		{
+			if (Samples.Num() < MaxSamplesPerAction)
+			{
+				Samples.Add(Sample);
+			}
+			else
+			{
+				Samples[NextSampleIndex] = Sample;
+				NextSampleIndex = (NextSampleIndex + 1) % MaxSamplesPerAction;
+			}
+		}
+	};
+
+	struct FPendingFrameEnd
+	{
+		FName ActionName;
+		FPressStamp Press;
+		FSample Sample;
+	};
+
+	/** Keyed by controller as well as key, so split-screen players pressing the same key in one frame keep their own stamps */
+	static TMap<TPair<int32, FKey>, FPressStamp> PressesByKey;
+	static TMap<FName, FActionSamples> SamplesByAction;
+	static TArray<FPendingFrameEnd> PendingFrameEnds;
+
+	/** The press being routed at the moment, if any */
+	static TOptional<FPressStamp> RoutingPress;
+	static float RoutingPressRoutedMs = 0.f;
+
+	static bool bIsListeningForFrameEnd = false;
+
+	float MillisecondsSince(const FPressStamp& Press)
+	{
+		return (float)((FPlatformTime::Seconds() - Press.Time) * 1000.);
+	}
+
+	void HandleEndFrame()
+	{
+		for (FPendingFrameEnd& Pending : PendingFrameEnds)
+		{
+			Pending.Sample.FrameEndMs = MillisecondsSince(Pending.Press);
+			Pending.Sample.FrameEndFrames = (int32)(GFrameCounter - Pending.Press.Frame);
+			SamplesByAction.FindOrAdd(Pending.ActionName).Add(Pending.Sample);
+		}
+		PendingFrameEnds.Reset();
+	}
+
+	template <typename ValueType>
+	ValueType GetPercentile(const TArray<ValueType>& SortedValues, float Percentile)
+	{
+		if (SortedValues.Num() == 0)
+		{
+			return ValueType();
+		}
+
+		const int32 ValueIndex = FMath::Clamp(FMath::CeilToInt(Percentile * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+		return SortedValues[ValueIndex];
+	}
+
+	template <typename ValueType>
+	void LogStage(FOutputDevice& Ar, const TCHAR* StageName, const TArray<FSample>& Samples, ValueType FSample::*Member, const TCHAR* Units)
+	{
+		TArray<ValueType> SortedValues;
+		SortedValues.Reserve(Samples.Num());
+		for (const FSample& Sample : Samples)
+		{
+			SortedValues.Add(Sample.*Member);
+		}
+		SortedValues.Sort();
+
+		Ar.Logf(TEXT("    %-10s p50: %8.3f%s  p90: %8.3f%s  p99: %8.3f%s  max: %8.3f%s"),
+			StageName,
+			(float)GetPercentile(SortedValues, 0.5f), Units,
+			(float)GetPercentile(SortedValues, 0.9f), Units,
+			(float)GetPercentile(SortedValues, 0.99f), Units,
+			(float)GetPercentile(SortedValues, 1.f), Units);
+	}
+}
+
+bool FCommonInputLatencyTracker::IsEnabled()
+{
+	return GCommonInputTraceLatency;
+}
+
+void FCommonInputLatencyTracker::MarkKeyEntered(int32 ControllerId, const FKey& Key)
+{
+	using namespace CommonInputLatency;
+
+	if (!GCommonInputTraceLatency)
+	{
+		return;
+	}
+
+	// The same press can reach us through both the Slate preprocessor and the viewport, the first one to see it wins
+	FPressStamp& Press = PressesByKey.FindOrAdd(TPair<int32, FKey>(ControllerId, Key));
+	if (Press.Time == 0. || Press.Frame != GFrameCounter)
+	{
+		Press.Time = FPlatformTime::Seconds();
+		Press.Frame = GFrameCounter;
+	}
+}
+
+void FCommonInputLatencyTracker::MarkActionFired(FName ActionName)
+{
+	using namespace CommonInputLatency;
+
+	if (!GCommonInputTraceLatency || !RoutingPress.IsSet())
+	{
+		return;
+	}
+
+	FPendingFrameEnd& Pending = PendingFrameEnds.AddDefaulted_GetRef();
+	Pending.ActionName = ActionName;
+	Pending.Press = RoutingPress.GetValue();
+	Pending.Sample.RoutedMs = RoutingPressRoutedMs;
+	Pending.Sample.FiredMs = MillisecondsSince(Pending.Press);
+
+	TRACE_BOOKMARK(TEXT("UI action %s (%.2fms after input)"), *ActionName.ToString(), Pending.Sample.FiredMs);
+
+	if (!bIsListeningForFrameEnd)
+	{
+		FCoreDelegates::OnEndFrame.AddStatic(&HandleEndFrame);
+		bIsListeningForFrameEnd = true;
+	}
+}
+
+void FCommonInputLatencyTracker::DumpLatencies(FOutputDevice& Ar)
+{
+	using namespace CommonInputLatency;
+
+	Ar.Logf(TEXT("Input latency by action (from the press entering the game, rendering excluded):"));
+
+	TArray<FName> ActionNames;
+	SamplesByAction.GetKeys(ActionNames);
+	ActionNames.Sort(FNameLexicalLess());
+
+	for (const FName& ActionName : ActionNames)
+	{
+		const TArray<FSample>& Samples = SamplesByAction[ActionName].Samples;
+		Ar.Logf(TEXT("  %s (%d samples)"), *ActionName.ToString(), Samples.Num());
+		LogStage(Ar, TEXT("Routed"), Samples, &FSample::RoutedMs, TEXT("ms"));
+		LogStage(Ar, TEXT("Fired"), Samples, &FSample::FiredMs, TEXT("ms"));
+		LogStage(Ar, TEXT("Frame end"), Samples, &FSample::FrameEndMs, TEXT("ms"));
+		LogStage(Ar, TEXT("Frames"), Samples, &FSample::FrameEndFrames, TEXT("  "));
+	}
+
+	if (ActionNames.Num() == 0)
+	{
+		Ar.Logf(TEXT("  No samples%s"), GCommonInputTraceLatency ? TEXT("") : TEXT(" (CommonInput.TraceInputLatency is off)"));
+	}
+}
+
+void FCommonInputLatencyTracker::Reset()
+{
+	using namespace CommonInputLatency;
+
+	PressesByKey.Reset();
+	SamplesByAction.Reset();
+	PendingFrameEnds.Reset();
+}
+
+FCommonInputLatencyTracker::FScopedKeyRouting::FScopedKeyRouting(int32 ControllerId, const FKey& Key)
+{
+	using namespace CommonInputLatency;
+
+	if (GCommonInputTraceLatency && !RoutingPress.IsSet())
+	{
+		const TPair<int32, FKey> PressKey(ControllerId, Key);
+		if (const FPressStamp* Press = PressesByKey.Find(PressKey))
+		{
+			RoutingPress = *Press;
+			RoutingPressRoutedMs = MillisecondsSince(*Press);
+			bIsTracking = true;
+
+			// A press is only routed once, anything after it (repeats, the release) doesn't count as a new press
+			PressesByKey.Remove(PressKey);
+		}
+	}
+}
+
+FCommonInputLatencyTracker::FScopedKeyRouting::~FScopedKeyRouting()
+{
+	if (bIsTracking)
+	{
+		CommonInputLatency::RoutingPress.Reset();
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithOutputDevice DumpInputLatencyCommand(
+	TEXT("CommonInput.DumpInputLatency"),
+	TEXT("Logs input-to-UI-action latency percentiles per action, gathered while CommonInput.TraceInputLatency is on"),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FCommonInputLatencyTracker::DumpLatencies)
+);
+
+static FAutoConsoleCommand ResetInputLatencyCommand(
+	TEXT("CommonInput.ResetInputLatency"),
+	TEXT("Discards all input latency samples gathered so far"),
+	FConsoleCommandDelegate::CreateStatic(&FCommonInputLatencyTracker::Reset)
+);
+#endif
@@ -3,11 +3,14 @@
 #include "CommonInputPrivatePCH.h"
 #include "ICommonInputModule.h"
 #include "Engine/AssetManager.h"
+#include "CommonUIStats.h"
 #if WITH_EDITOR
 #include "ISettingsModule.h"
 #include "ISettingsSection.h"
 #endif // WITH_EDITOR
 
+CSV_DEFINE_CATEGORY_MODULE(COMMONINPUT_API, CommonUI, true);
+
 /**
  * Implements the FCommonInputModule module.
  */
@@ -11,6 +11,7 @@
 #include "Widgets/SViewport.h"
 #include "HAL/IConsoleManager.h"
 #include "CommonInputSettings.h"
+#include "CommonInputLatencyTracker.h"
 #include "Containers/Ticker.h"
 #include "GenericPlatform/GenericPlatformTime.h"
 #include "ICommonInputModule.h"
@@ -21,6 +22,11 @@
 #if WITH_EDITOR
 #include "Settings/LevelEditorPlaySettings.h"
 #endif
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CommonInputSubsystem Tick"), STAT_CommonInputSubsystem_Tick, STATGROUP_CommonUI);
+DECLARE_CYCLE_STAT(TEXT("CommonInputSubsystem BroadcastInputMethodChanged"), STAT_CommonInputSubsystem_BroadcastInputMethodChanged, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonInputSubsystem Input Method Broadcasts"), STAT_CommonInputSubsystem_InputMethodBroadcasts, STATGROUP_CommonUI);
 
 /**
  * Helper class that is designed to fire before any UI has a chance to process input so that
@@ -53,6 +59,11 @@ public:
 
 	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
 	{
+		if (!InKeyEvent.IsRepeat())
+		{
+			FCommonInputLatencyTracker::MarkKeyEntered(InKeyEvent.GetUserIndex(), InKeyEvent.GetKey());
+		}
+
 		const ECommonInputType InputType = GetInputType(InKeyEvent.GetKey());
 		if (IsRelevantInput(SlateApp, InKeyEvent, InputType))
 		{
@@ -387,6 +398,10 @@ void UCommonInputSubsystem::BroadcastInputMethodChanged()
 	{
 		if (!World->bIsTearingDown)
 		{
+			SCOPE_CYCLE_COUNTER(STAT_CommonInputSubsystem_BroadcastInputMethodChanged);
+			CSV_SCOPED_TIMING_STAT(CommonUI, BroadcastInputMethodChanged);
+			INC_DWORD_STAT(STAT_CommonInputSubsystem_InputMethodBroadcasts);
+
 			OnInputMethodChangedNative.Broadcast(CurrentInputType);
 			OnInputMethodChanged.Broadcast(CurrentInputType);
 			LastInputMethodChangeTime = FPlatformTime::Seconds();
@@ -545,7 +560,7 @@ bool UCommonInputSubsystem::ShouldShowInputKeys() const
 
 bool UCommonInputSubsystem::Tick(float DeltaTime)
 {
-	QUICK_SCOPE_CYCLE_COUNTER(STAT_UCommonInputSubsystem_Tick);
+	SCOPE_CYCLE_COUNTER(STAT_CommonInputSubsystem_Tick);
 
 	//@todo DanH: This is wrong now that two of these might exist (and has always been wrong for multi-client PIE scenarios)
 	//		Preprocessors need to be kept associated with their registration priority so we can safely know these won't get all thrown out of whack as others come and go
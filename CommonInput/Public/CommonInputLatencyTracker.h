@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputCoreTypes.h"
+
+/**
+ * Measures how long key presses take to become UI actions, broken down by the stage they've reached:
+ *	Routed		- The press is handed to the UI action router
+ *	Fired		- The action's delegate fires (attributed to the press being routed at the time)
+ *	Frame end	- The end of the game frame in which the action fired, i.e. when its effects are ready to be drawn
+ *
+ * All stages are measured from the press first reaching the game (Slate preprocessor or viewport, whichever sees it
+ * first). Rendering and display are not included, so the numbers are a floor on what the player perceives.
+ *
+ * Does nothing unless CommonInput.TraceInputLatency is set. Results are logged per action with CommonInput.DumpInputLatency
+ * and each fired action is also marked with a bookmark in Insights.
+ */
+class COMMONINPUT_API FCommonInputLatencyTracker
+{
+public:
+	static bool IsEnabled();
+
+	/**
+	 * Stamps a key press as it enters the game. Repeat stamps for the same press within a frame are ignored.
+	 * Slate events pass their user index as the controller id, which Slate maps one to one by default.
+	 */
+	static void MarkKeyEntered(int32 ControllerId, const FKey& Key);
+
+	/** Records that the named action fired, attributing it to the key press currently being routed (if any) */
+	static void MarkActionFired(FName ActionName);
+
+	/** Logs latency percentiles for every action fired since tracing started or was last reset */
+	static void DumpLatencies(FOutputDevice& Ar);
+	static void Reset();
+
+	/** Scopes the routing of a key press through the UI, so any actions fired within are attributed to the press */
+	struct COMMONINPUT_API FScopedKeyRouting
+	{
+		FScopedKeyRouting(int32 ControllerId, const FKey& Key);
+		~FScopedKeyRouting();
+
+	private:
+		bool bIsTracking = false;
+	};
+};
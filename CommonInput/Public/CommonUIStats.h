@@ -0,0 +1,16 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/**
+ * Everything CommonUI costs in a frame, for "stat CommonUI". The hot paths also record timings to the CommonUI CSV
+ * category, so they can still be captured in builds without stats.
+ *
+ * Lives in CommonInput rather than CommonUI so that both modules of the plugin can report to the same group.
+ */
+DECLARE_STATS_GROUP(TEXT("CommonUI"), STATGROUP_CommonUI, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(COMMONINPUT_API, CommonUI);
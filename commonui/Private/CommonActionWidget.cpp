@@ -10,6 +10,9 @@
 #include "CommonUITypes.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Input/UIActionRouterTypes.h"
+#include "CommonUIStats.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CommonActionWidget Built"), STAT_CommonActionWidget_Built, STATGROUP_CommonUI);
 
 UCommonActionWidget::UCommonActionWidget(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -80,12 +83,19 @@ TSharedRef<SWidget> UCommonActionWidget::RebuildWidget()
 			SAssignNew(MyProgressImage, SImage)
 			.Image(&ProgressMaterialBrush)
 		]);
+
+	INC_DWORD_STAT(STAT_CommonActionWidget_Built);
 	
 	return MyKeyBox.ToSharedRef();
 }
 
 void UCommonActionWidget::ReleaseSlateResources(bool bReleaseChildren)
 {
+	if (MyKeyBox.IsValid())
+	{
+		DEC_DWORD_STAT(STAT_CommonActionWidget_Built);
+	}
+
 	MyProgressImage.Reset();
 	MyIcon.Reset();
 	MyKeyBox.Reset();
@@ -4,8 +4,20 @@
 #include "CommonUIPrivatePCH.h"
 #include "Input/CommonUIInputTypes.h"
 #include "ICommonInputModule.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/ScrollBox.h"
+#include "Components/ListView.h"
+#include "Components/PanelWidget.h"
+#include "CommonLoadGuard.h"
+#include "Containers/Ticker.h"
+#include "Widgets/Layout/SBox.h"
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CommonActivatableWidget AsyncBuild"), STAT_CommonActivatableWidget_AsyncBuild, STATGROUP_CommonUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CommonActivatableWidget Released While Deactivated"), STAT_CommonActivatableWidget_ReleasedWhileDeactivated, STATGROUP_CommonUI);
 
 UCommonActivatableWidget::FActivatableWidgetRebuildEvent UCommonActivatableWidget::OnRebuilding;
+UCommonActivatableWidget::FActivatableWidgetActivationEvent UCommonActivatableWidget::OnActivationChanged;
 
 void UCommonActivatableWidget::NativeConstruct()
 {
@@ -33,6 +45,9 @@ void UCommonActivatableWidget::NativeDestruct()
 		// If there's no game instance, any cleanup done in Deactivation will be irrelevant; we're shutting down the game
 		DeactivateWidget();
 	}
+
+	// Nothing left to release once we're destructed
+	ClearSlateReleaseTicker();
 	Super::NativeDestruct();
 }
 
@@ -64,19 +79,32 @@ void UCommonActivatableWidget::RequestRefreshFocus()
 
 void UCommonActivatableWidget::ActivateWidget()
 {
-	if (!bIsActive)
+	if (IsBuildingAsynchronously())
+	{
+		UE_LOG(LogCommonUI, Verbose, TEXT("[%s] is still building, deferring activation until it's complete"), *GetName());
+		bActivateWhenAsyncBuilt = true;
+	}
+	else if (!bIsActive)
 	{
 		InternalProcessActivation();
 	}
 }
 void UCommonActivatableWidget::InternalProcessActivation()
 {
+	ClearSlateReleaseTicker();
+	if (bIsSlateReleasedWhileDeactivated)
+	{
+		RestoreDeactivatedSlate();
+	}
+
 	bIsActive = true;
 	NativeOnActivated();
+	OnActivationChanged.Broadcast(*this);
 }
 
 void UCommonActivatableWidget::DeactivateWidget()
 {
+	bActivateWhenAsyncBuilt = false;
 	if (bIsActive)
 	{
 		InternalProcessDeactivation();
@@ -87,6 +115,112 @@ void UCommonActivatableWidget::InternalProcessDeactivation()
 {
 	bIsActive = false;
 	NativeOnDeactivated();
+	OnActivationChanged.Broadcast(*this);
+
+	// Wall-clock seconds on the core ticker, so the release still happens beneath a pause menu and regardless of time dilation
+	if (bReleaseSlateWhenDeactivated && ReleasableContentBox.IsValid() && !SlateReleaseTickerHandle.IsValid())
+	{
+		SlateReleaseTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCommonActivatableWidget::HandleSlateReleaseTick), SlateReleaseDelay);
+	}
+}
+
+bool UCommonActivatableWidget::HandleSlateReleaseTick(float DeltaTime)
+{
+	SlateReleaseTickerHandle.Reset();
+	ReleaseDeactivatedSlate();
+	return false;
+}
+
+void UCommonActivatableWidget::ClearSlateReleaseTicker()
+{
+	if (SlateReleaseTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(SlateReleaseTickerHandle);
+		SlateReleaseTickerHandle.Reset();
+	}
+}
+
+void UCommonActivatableWidget::ReleaseDeactivatedSlate()
+{
+	if (bIsActive || bIsSlateReleasedWhileDeactivated || !ReleasableContentBox.IsValid() || !WidgetTree || !WidgetTree->RootWidget)
+	{
+		return;
+	}
+
+	UE_LOG(LogCommonUI, Verbose, TEXT("[%s] releasing Slate resources after remaining deactivated for %.1fs"), *GetName(), SlateReleaseDelay);
+
+	SlateRestoreState = FSlateRestoreState();
+	SlateRestoreState.FocusTarget = GetDesiredFocusTarget();
+	WidgetTree->ForEachWidget([this](UWidget* Widget)
+		{
+			if (UScrollBox* ScrollBox = Cast<UScrollBox>(Widget))
+			{
+				SlateRestoreState.ScrollBoxOffsets.Emplace(ScrollBox, ScrollBox->GetScrollOffset());
+			}
+			else if (UListView* ListView = Cast<UListView>(Widget))
+			{
+				SlateRestoreState.ListViewOffsets.Emplace(ListView, ListView->GetScrollOffset());
+
+				TArray<UObject*> SelectedItems;
+				if (ListView->GetSelectedItems(SelectedItems) > 0)
+				{
+					SlateRestoreState.ListViewSelections.Emplace(ListView, TArray<TWeakObjectPtr<UObject>>(SelectedItems));
+				}
+			}
+		});
+
+	bIsSlateReleasedWhileDeactivated = true;
+	ReleasableContentBox->SetContent(SNullWidget::NullWidget);
+	WidgetTree->RootWidget->ReleaseSlateResources(true);
+	INC_DWORD_STAT(STAT_CommonActivatableWidget_ReleasedWhileDeactivated);
+}
+
+void UCommonActivatableWidget::RestoreDeactivatedSlate()
+{
+	UE_LOG(LogCommonUI, Verbose, TEXT("[%s] rebuilding Slate resources released while deactivated"), *GetName());
+
+	bIsSlateReleasedWhileDeactivated = false;
+	DEC_DWORD_STAT(STAT_CommonActivatableWidget_ReleasedWhileDeactivated);
+
+	if (ReleasableContentBox.IsValid() && WidgetTree && WidgetTree->RootWidget)
+	{
+		ReleasableContentBox->SetContent(WidgetTree->RootWidget->TakeWidget());
+	}
+
+	for (const TPair<TWeakObjectPtr<UScrollBox>, float>& ScrollBoxOffset : SlateRestoreState.ScrollBoxOffsets)
+	{
+		if (UScrollBox* ScrollBox = ScrollBoxOffset.Key.Get())
+		{
+			ScrollBox->SetScrollOffset(ScrollBoxOffset.Value);
+		}
+	}
+	for (const TPair<TWeakObjectPtr<UListView>, float>& ListViewOffset : SlateRestoreState.ListViewOffsets)
+	{
+		if (UListView* ListView = ListViewOffset.Key.Get())
+		{
+			ListView->SetScrollOffset(ListViewOffset.Value);
+		}
+	}
+	for (const TPair<TWeakObjectPtr<UListView>, TArray<TWeakObjectPtr<UObject>>>& ListViewSelection : SlateRestoreState.ListViewSelections)
+	{
+		if (UListView* ListView = ListViewSelection.Key.Get())
+		{
+			for (const TWeakObjectPtr<UObject>& SelectedItem : ListViewSelection.Value)
+			{
+				if (SelectedItem.IsValid())
+				{
+					ListView->SetItemSelection(SelectedItem.Get(), true);
+				}
+			}
+		}
+	}
+
+	// The focus target has only just been rebuilt, so make sure focus lands on the new widget rather than whatever was cached for the old one
+	if (SlateRestoreState.FocusTarget.IsValid())
+	{
+		OnRequestRefreshFocusEvent.Broadcast();
+	}
+	SlateRestoreState = FSlateRestoreState();
 }
 
 TSharedRef<SWidget> UCommonActivatableWidget::RebuildWidget()
@@ -96,14 +230,157 @@ TSharedRef<SWidget> UCommonActivatableWidget::RebuildWidget()
 	if (!IsDesignTime())
 	{
 		OnRebuilding.Broadcast(*this);
+
+		if (bBuildAsynchronously && WidgetTree && WidgetTree->RootWidget)
+		{
+			CancelAsyncBuild();
+
+			// Sub-widgets need their player context before they're built, same as they'd get from UUserWidget::RebuildWidget
+			if (PlayerContext.IsValid())
+			{
+				WidgetTree->ForEachWidget([this](UWidget* Widget)
+					{
+						if (UUserWidget* UserWidget = Cast<UUserWidget>(Widget))
+						{
+							UserWidget->SetPlayerContext(PlayerContext);
+						}
+					});
+			}
+
+			// Each widget's TakeWidget reuses the already built widgets of its children, so building leaves first lets every frame do a bounded
+			// amount of the work, leaving the root with little more than its own widget to build at the end
+			TFunction<void(UWidget*)> GatherBuildOrder = [&GatherBuildOrder](UWidget* Widget)
+			{
+				if (const UPanelWidget* PanelWidget = Cast<UPanelWidget>(Widget))
+				{
+					for (int32 ChildIdx = 0; ChildIdx < PanelWidget->GetChildrenCount(); ++ChildIdx)
+					{
+						if (UWidget* Child = PanelWidget->GetChildAt(ChildIdx))
+						{
+							GatherBuildOrder(Child);
+						}
+					}
+				}
+				else if (const UUserWidget* UserWidget = Cast<UUserWidget>(Widget))
+				{
+					if (UserWidget->WidgetTree && UserWidget->WidgetTree->RootWidget)
+					{
+						GatherBuildOrder(UserWidget->WidgetTree->RootWidget);
+					}
+				}
+				PendingAsyncBuildWidgets.Add(Widget);
+			};
+			GatherBuildOrder(WidgetTree->RootWidget);
+
+			AsyncBuildStartTime = FPlatformTime::Seconds();
+			AsyncBuildTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCommonActivatableWidget::HandleAsyncBuildTick));
+
+			SAssignNew(AsyncBuildGuard, SLoadGuard);
+			AsyncBuildGuard->SetForceShowSpinner(true);
+			return AsyncBuildGuard.ToSharedRef();
+		}
 	}
 	
+	return BuildContent();
+}
+
+TSharedRef<SWidget> UCommonActivatableWidget::BuildContent()
+{
+	if (bReleaseSlateWhenDeactivated && !IsDesignTime())
+	{
+		return SAssignNew(ReleasableContentBox, SBox)
+			[
+				Super::RebuildWidget()
+			];
+	}
 	return Super::RebuildWidget();
 }
 
+bool UCommonActivatableWidget::HandleAsyncBuildTick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CommonActivatableWidget_AsyncBuild);
+
+	++NumAsyncBuildFrames;
+	const double BudgetEndTime = FPlatformTime::Seconds() + AsyncBuildFrameBudgetMs / 1000.;
+	while (NextAsyncBuildIdx < PendingAsyncBuildWidgets.Num())
+	{
+		// Always build at least one widget per frame, however expensive it is
+		if (UWidget* Widget = PendingAsyncBuildWidgets[NextAsyncBuildIdx++].Get())
+		{
+			AsyncBuiltWidgets.Add(Widget->TakeWidget());
+		}
+
+		if (FPlatformTime::Seconds() >= BudgetEndTime)
+		{
+			break;
+		}
+	}
+
+	if (NextAsyncBuildIdx < PendingAsyncBuildWidgets.Num())
+	{
+		return true;
+	}
+
+	AsyncBuildTickerHandle.Reset();
+	if (AsyncBuildGuard.IsValid())
+	{
+		AsyncBuildGuard->SetContent(BuildContent());
+		AsyncBuildGuard->SetForceShowSpinner(false);
+
+		// OnWidgetRebuilt built navigation while nothing in the tree had a Slate widget yet, which silently dropped any explicit rules
+		if (WidgetTree)
+		{
+			WidgetTree->ForEachWidget([](UWidget* Widget) { Widget->BuildNavigation(); });
+		}
+	}
+	AsyncBuiltWidgets.Reset();
+	PendingAsyncBuildWidgets.Reset();
+	NextAsyncBuildIdx = 0;
+
+	UE_LOG(LogCommonUI, Verbose, TEXT("[%s] finished building over %d frames (%.2fms)"), *GetName(), NumAsyncBuildFrames, (FPlatformTime::Seconds() - AsyncBuildStartTime) * 1000.);
+	NumAsyncBuildFrames = 0;
+
+	OnAsyncBuildCompleteEvent.Broadcast();
+
+	if (bActivateWhenAsyncBuilt)
+	{
+		bActivateWhenAsyncBuilt = false;
+		ActivateWidget();
+	}
+	return false;
+}
+
+void UCommonActivatableWidget::CancelAsyncBuild()
+{
+	if (AsyncBuildTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(AsyncBuildTickerHandle);
+		AsyncBuildTickerHandle.Reset();
+	}
+	PendingAsyncBuildWidgets.Reset();
+	AsyncBuiltWidgets.Reset();
+	NextAsyncBuildIdx = 0;
+	NumAsyncBuildFrames = 0;
+	bActivateWhenAsyncBuilt = false;
+}
+
 void UCommonActivatableWidget::ReleaseSlateResources(bool bReleaseChildren)
 {
 	Super::ReleaseSlateResources(bReleaseChildren);
+
+	ClearSlateReleaseTicker();
+
+	if (bIsSlateReleasedWhileDeactivated)
+	{
+		bIsSlateReleasedWhileDeactivated = false;
+		SlateRestoreState = FSlateRestoreState();
+		DEC_DWORD_STAT(STAT_CommonActivatableWidget_ReleasedWhileDeactivated);
+	}
+	ReleasableContentBox.Reset();
+
+	CancelAsyncBuild();
+	AsyncBuildGuard.Reset();
+
 	OnSlateReleased().Broadcast();
 }
 
@@ -5,6 +5,16 @@
 #include "Components/PanelSlot.h"
 #include "Widgets/SOverlay.h"
 #include "Widgets/Layout/SSpacer.h"
+#include "Widgets/Layout/SBox.h"
+#include "Containers/Ticker.h"
+#include "CommonUIPrivatePCH.h"
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CommonAnimatedSwitcher Transition"), STAT_CommonAnimatedSwitcher_Transition, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonAnimatedSwitcher Transitions"), STAT_CommonAnimatedSwitcher_Transitions, STATGROUP_CommonUI);
+DECLARE_CYCLE_STAT(TEXT("CommonAnimatedSwitcher BuildLazyChild"), STAT_CommonAnimatedSwitcher_BuildLazyChild, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonAnimatedSwitcher Children Deferred"), STAT_CommonAnimatedSwitcher_ChildrenDeferred, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonAnimatedSwitcher Deferred Children Built"), STAT_CommonAnimatedSwitcher_DeferredChildrenBuilt, STATGROUP_CommonUI);
 
 UCommonAnimatedSwitcher::UCommonAnimatedSwitcher(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -21,6 +31,25 @@ void UCommonAnimatedSwitcher::ReleaseSlateResources(bool bReleaseChildren)
 
 	bSetOnce = false;
 
+	if (LazyChildren.Num() > 0)
+	{
+		int32 NumBuilt = 0;
+		for (const TPair<UPanelSlot*, FLazyChild>& LazyChildPair : LazyChildren)
+		{
+			NumBuilt += LazyChildPair.Value.bIsBuilt ? 1 : 0;
+		}
+		UE_LOG(LogCommonUI, Verbose, TEXT("[%s] %d of %d children were never built, building the other %d on demand took %.2fms"),
+			*GetName(), LazyChildren.Num() - NumBuilt, LazyChildren.Num(), NumBuilt, LazyChildBuildTime * 1000.);
+	}
+	LazyChildren.Reset();
+	PendingPrefetches.Reset();
+	LazyChildBuildTime = 0.;
+	if (PrefetchTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(PrefetchTickerHandle);
+		PrefetchTickerHandle.Reset();
+	}
+
 	MyOverlay.Reset();
 	MyInputGuard.Reset();
 	MyAnimatedSwitcher.Reset();
@@ -108,15 +137,39 @@ TSharedRef<SWidget> UCommonAnimatedSwitcher::RebuildWidget()
 		.OnActiveIndexChanged_UObject(this, &UCommonAnimatedSwitcher::HandleSlateActiveIndexChanged)
 		.OnIsTransitioningChanged_UObject(this, &UCommonAnimatedSwitcher::HandleSlateIsTransitioningChanged);
 
+	const bool bBuildLazily = bBuildChildrenLazily && !IsDesignTime();
 	for (UPanelSlot* CurrentSlot : Slots)
 	{
 		if (UWidgetSwitcherSlot* TypedSlot = Cast<UWidgetSwitcherSlot>(CurrentSlot))
 		{
 			TypedSlot->Parent = this;
-			TypedSlot->BuildSlot(MyWidgetSwitcher.ToSharedRef());
+			if (bBuildLazily)
+			{
+				// Stand in an empty box for the child until it's actually needed
+				TSharedRef<SBox> Container = SNew(SBox);
+				MyWidgetSwitcher->AddSlot()
+					.Padding(TypedSlot->Padding)
+					.HAlign(TypedSlot->HorizontalAlignment)
+					.VAlign(TypedSlot->VerticalAlignment)
+					[
+						Container
+					];
+				LazyChildren.Add(TypedSlot, FLazyChild{ Container });
+			}
+			else
+			{
+				TypedSlot->BuildSlot(MyWidgetSwitcher.ToSharedRef());
+			}
 		}
 	}
 
+	if (bBuildLazily && Slots.IsValidIndex(ActiveWidgetIndex))
+	{
+		BuildLazyChild(Slots[ActiveWidgetIndex]);
+		PrefetchNeighbours(ActiveWidgetIndex);
+	}
+	INC_DWORD_STAT_BY(STAT_CommonAnimatedSwitcher_ChildrenDeferred, LazyChildren.Num());
+
 	return SAssignNew(MyOverlay, SOverlay)
 		+ SOverlay::Slot()
 		[
@@ -129,6 +182,23 @@ TSharedRef<SWidget> UCommonAnimatedSwitcher::RebuildWidget()
 		];
 }
 
+void UCommonAnimatedSwitcher::OnSlotRemoved(UPanelSlot* InSlot)
+{
+	// Lazily built children live within a container of ours, so it's the container that needs removing from the switcher
+	if (const FLazyChild* LazyChild = LazyChildren.Find(InSlot))
+	{
+		if (MyWidgetSwitcher.IsValid())
+		{
+			MyWidgetSwitcher->RemoveSlot(LazyChild->Container);
+		}
+		LazyChildren.Remove(InSlot);
+	}
+	else
+	{
+		Super::OnSlotRemoved(InSlot);
+	}
+}
+
 void UCommonAnimatedSwitcher::HandleSlateIsTransitioningChanged(bool bIsTransitioning)
 {
 	// While the switcher is transitioning, put up the guard to intercept all input
@@ -147,10 +217,20 @@ void UCommonAnimatedSwitcher::SetActiveWidgetIndex_Internal(int32 Index)
 
 	if (Index >= 0 && Index < Slots.Num() && (Index != ActiveWidgetIndex || !bSetOnce))
 	{
+		SCOPE_CYCLE_COUNTER(STAT_CommonAnimatedSwitcher_Transition);
+		CSV_SCOPED_TIMING_STAT(CommonUI, AnimatedSwitcherTransition);
+		INC_DWORD_STAT(STAT_CommonAnimatedSwitcher_Transitions);
+
 		HandleOutgoingWidget();
 
 		ActiveWidgetIndex = Index;
 
+		if (LazyChildren.Num() > 0)
+		{
+			BuildLazyChild(Slots[Index]);
+			PrefetchNeighbours(Index);
+		}
+
 		if (MyAnimatedSwitcher.IsValid())
 		{
 			// Ensure the index is clamped to a valid range.
@@ -167,3 +247,77 @@ void UCommonAnimatedSwitcher::SetActiveWidgetIndex_Internal(int32 Index)
 		bSetOnce = true;
 	}
 }
+
+
+void UCommonAnimatedSwitcher::BuildLazyChild(UPanelSlot* ChildSlot)
+{
+	FLazyChild* LazyChild = LazyChildren.Find(ChildSlot);
+	if (LazyChild && !LazyChild->bIsBuilt)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_CommonAnimatedSwitcher_BuildLazyChild);
+		const double StartTime = FPlatformTime::Seconds();
+
+		LazyChild->bIsBuilt = true;
+		LazyChild->Container->SetContent(ChildSlot->Content ? ChildSlot->Content->TakeWidget() : SNullWidget::NullWidget);
+
+		LazyChildBuildTime += FPlatformTime::Seconds() - StartTime;
+		INC_DWORD_STAT(STAT_CommonAnimatedSwitcher_DeferredChildrenBuilt);
+	}
+}
+
+void UCommonAnimatedSwitcher::PrefetchNeighbours(int32 Index)
+{
+	// The neighbours are the likeliest to be activated next (ActivateNextWidget/ActivatePreviousWidget), so get them built in the following frames
+	// rather than paying for them when the transition starts
+	const int32 NeighbourIndices[] = { (Index + 1) % Slots.Num(), (Index + Slots.Num() - 1) % Slots.Num() };
+	for (const int32 NeighbourIndex : NeighbourIndices)
+	{
+		UPanelSlot* NeighbourSlot = Slots[NeighbourIndex];
+		const FLazyChild* LazyChild = LazyChildren.Find(NeighbourSlot);
+		if (LazyChild && !LazyChild->bIsBuilt && !PendingPrefetches.Contains(NeighbourSlot))
+		{
+			if (PrepareLazyChild.IsBound())
+			{
+				PrepareLazyChild.Execute(NeighbourSlot->Content, FSimpleDelegate::CreateUObject(this, &UCommonAnimatedSwitcher::HandleLazyChildPrepared, TWeakObjectPtr<UPanelSlot>(NeighbourSlot)));
+			}
+			else
+			{
+				HandleLazyChildPrepared(NeighbourSlot);
+			}
+		}
+	}
+}
+
+void UCommonAnimatedSwitcher::HandleLazyChildPrepared(TWeakObjectPtr<UPanelSlot> ChildSlot)
+{
+	if (ChildSlot.IsValid() && LazyChildren.Contains(ChildSlot.Get()))
+	{
+		PendingPrefetches.AddUnique(ChildSlot);
+		if (!PrefetchTickerHandle.IsValid())
+		{
+			PrefetchTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCommonAnimatedSwitcher::HandlePrefetchTick));
+		}
+	}
+}
+
+bool UCommonAnimatedSwitcher::HandlePrefetchTick(float DeltaTime)
+{
+	// One child per frame, so prefetching never costs more than the child would have when activated
+	while (PendingPrefetches.Num() > 0)
+	{
+		UPanelSlot* ChildSlot = PendingPrefetches[0].Get();
+		PendingPrefetches.RemoveAt(0);
+		if (ChildSlot)
+		{
+			BuildLazyChild(ChildSlot);
+			break;
+		}
+	}
+
+	if (PendingPrefetches.Num() == 0)
+	{
+		PrefetchTickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
\ No newline at end of file
@@ -24,6 +24,11 @@
 #include "CommonUIUtils.h"
 #include "Input/CommonUIInputTypes.h"
 #include "Sound/SoundBase.h"
+#include "CommonInputLatencyTracker.h"
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CommonButtonBase BuildStyles"), STAT_CommonButtonBase_BuildStyles, STATGROUP_CommonUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CommonButtonBase Constructed"), STAT_CommonButtonBase_Constructed, STATGROUP_CommonUI);
 
 //////////////////////////////////////////////////////////////////////////
 // UCommonButtonStyle
@@ -304,6 +309,10 @@ void UCommonButtonInternalBase::SlateHandleOnReceivedFocus()
 // UCommonButtonBase
 //////////////////////////////////////////////////////////////////////////
 
+UCommonButtonBase::FCommonButtonLifetimeEvent UCommonButtonBase::OnButtonConstructed;
+UCommonButtonBase::FCommonButtonLifetimeEvent UCommonButtonBase::OnButtonDestructed;
+UCommonButtonBase::FCommonButtonPaintEvent UCommonButtonBase::OnButtonPaintedRectChanged;
+
 UCommonButtonBase::UCommonButtonBase(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, MinWidth(0)
@@ -414,6 +423,12 @@ void UCommonButtonBase::NativeConstruct()
 	UpdateInputActionWidget();
 
 	Super::NativeConstruct();
+
+	if (!IsDesignTime())
+	{
+		INC_DWORD_STAT(STAT_CommonButtonBase_Constructed);
+		OnButtonConstructed.Broadcast(*this);
+	}
 }
 
 void UCommonButtonBase::NativeDestruct()
@@ -422,6 +437,30 @@ void UCommonButtonBase::NativeDestruct()
 
 	UnbindTriggeringInputActionToClick();
 	UnbindInputMethodChangedDelegate();
+
+	if (!IsDesignTime())
+	{
+		DEC_DWORD_STAT(STAT_CommonButtonBase_Constructed);
+		OnButtonDestructed.Broadcast(*this);
+	}
+}
+
+int32 UCommonButtonBase::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	// Listeners only hear about buttons that moved or came back on screen, so a static screen costs nothing beyond the compare
+	const FSlateRect PaintedRect = AllottedGeometry.GetLayoutBoundingRect();
+	const bool bWasUnpainted = LastPaintFrame == 0 || GFrameCounter > LastPaintFrame + 1;
+	LastPaintFrame = GFrameCounter;
+	if (bWasUnpainted || PaintedRect != LastPaintedRect)
+	{
+		LastPaintedRect = PaintedRect;
+		if (!IsDesignTime())
+		{
+			OnButtonPaintedRectChanged.Broadcast(*this);
+		}
+	}
+
+	return Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
 }
 
 void UCommonButtonBase::SetIsEnabled(bool bInIsEnabled)
@@ -505,6 +544,12 @@ void UCommonButtonBase::HandleTriggeringActionCommited(bool& bPassthrough)
 {
 	// Because this path doesn't go through SButton::Press(), the sound needs to be played from here.
 	FSlateApplication::Get().PlaySound(NormalStyle.PressedSlateSound);
+
+	if (FCommonInputLatencyTracker::IsEnabled())
+	{
+		FCommonInputLatencyTracker::MarkActionFired(TriggeringInputAction.IsNull() ? GetFName() : TriggeringInputAction.RowName);
+	}
+
 	HandleButtonClicked();
 }
 
@@ -1170,6 +1215,9 @@ void UCommonButtonBase::NativeOnCurrentTextStyleChanged()
 
 void UCommonButtonBase::BuildStyles()
 {
+	SCOPE_CYCLE_COUNTER(STAT_CommonButtonBase_BuildStyles);
+	CSV_SCOPED_TIMING_STAT(CommonUI, ButtonBuildStyles);
+
 	if (const UCommonButtonStyle* CommonButtonStyle = GetStyleCDO())
 	{
 		const FMargin& ButtonPadding = CommonButtonStyle->ButtonPadding;
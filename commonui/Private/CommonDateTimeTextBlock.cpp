@@ -6,8 +6,9 @@
 #include "TimerManager.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Framework/Application/SlateApplication.h"
+#include "CommonUIStats.h"
 
-DECLARE_CYCLE_STAT(TEXT("CommonDateTimeTextBlock UpdateUnderlyingText"), STAT_CommonDateTimeTextBlock_UpdateUnderlyingText, STATGROUP_UI);
+DECLARE_CYCLE_STAT(TEXT("CommonDateTimeTextBlock UpdateUnderlyingText"), STAT_CommonDateTimeTextBlock_UpdateUnderlyingText, STATGROUP_CommonUI);
 
 
 UCommonDateTimeTextBlock::UCommonDateTimeTextBlock(const FObjectInitializer& ObjectInitializer)
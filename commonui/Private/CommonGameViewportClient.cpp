@@ -6,6 +6,7 @@
 #include "Engine/LocalPlayer.h"
 #include "GameFramework/GameUserSettings.h"
 #include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
 
 #if WITH_EDITOR
 #include "Editor.h"
@@ -14,17 +15,33 @@
 
 #include "Input/CommonUIActionRouterBase.h"
 #include "Framework/Application/SlateUser.h"
+#include "CommonInputLatencyTracker.h"
+#include "CommonUIStats.h"
 
 #define LOCTEXT_NAMESPACE ""
 
 static const FName NAME_Typing = FName(TEXT("Typing"));
 static const FName NAME_Open = FName(TEXT("Open"));
 
+bool GCommonBatchAxisInput = false;
+static FAutoConsoleVariableRef CVarCommonBatchAxisInput(
+	TEXT("CommonUI.BatchAxisInput"),
+	GCommonBatchAxisInput,
+	TEXT("If true, each axis of each controller is rerouted to the UI once per frame, with any further samples that frame following the UI's verdict on the first"),
+	ECVF_Default
+);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonGameViewportClient Axis Samples Rerouted"), STAT_CommonGameViewportClient_AxisSamplesRerouted, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonGameViewportClient Axis Samples Batched"), STAT_CommonGameViewportClient_AxisSamplesBatched, STATGROUP_CommonUI);
+
 UCommonGameViewportClient::UCommonGameViewportClient(FVTableHelper& Helper) : Super(Helper)
 {
 	OnRerouteInput().BindUObject(this, &UCommonGameViewportClient::HandleRerouteInput);
 	OnRerouteAxis().BindUObject(this, &UCommonGameViewportClient::HandleRerouteAxis);
 	OnRerouteTouch().BindUObject(this, &UCommonGameViewportClient::HandleRerouteTouch);
+
+	OnPlayerAdded().AddUObject(this, &UCommonGameViewportClient::HandlePlayerAddedOrRemoved);
+	OnPlayerRemoved().AddUObject(this, &UCommonGameViewportClient::HandlePlayerAddedOrRemoved);
 }
 
 UCommonGameViewportClient::~UCommonGameViewportClient()
@@ -35,6 +52,11 @@ bool UCommonGameViewportClient::InputKey(const FInputKeyEventArgs& InEventArgs)
 {
 	const FInputKeyEventArgs& EventArgs = InEventArgs;
 
+	if (EventArgs.Event == IE_Pressed)
+	{
+		FCommonInputLatencyTracker::MarkKeyEntered(EventArgs.ControllerId, EventArgs.Key);
+	}
+
 	if (IsKeyPriorityAboveUI(EventArgs))
 	{
 		return true;
@@ -59,9 +81,33 @@ bool UCommonGameViewportClient::InputKey(const FInputKeyEventArgs& InEventArgs)
 bool UCommonGameViewportClient::InputAxis(FViewport* InViewport, int32 UserId, FKey Key, float Delta, float DeltaTime, int32 NumSamples, bool bGamepad)
 {
 	int32 ControllerId = UserId;
+
+	// High polling rate mice and gyros can send many samples of an axis per frame, but the UI's verdict on them won't change within a frame,
+	// so there's no need to pay for rerouting more than one of them
+	if (GCommonBatchAxisInput)
+	{
+		if (AxisRerouteResultsFrame != GFrameCounter)
+		{
+			AxisRerouteResults.Reset();
+			AxisRerouteResultsFrame = GFrameCounter;
+		}
+
+		if (const bool* bWasHandled = AxisRerouteResults.Find(TPair<int32, FKey>(ControllerId, Key)))
+		{
+			INC_DWORD_STAT(STAT_CommonGameViewportClient_AxisSamplesBatched);
+			return *bWasHandled || Super::InputAxis(InViewport, ControllerId, Key, Delta, DeltaTime, NumSamples, bGamepad);
+		}
+	}
+
+	INC_DWORD_STAT(STAT_CommonGameViewportClient_AxisSamplesRerouted);
 	FReply RerouteResult = FReply::Unhandled();
 
 	OnRerouteAxis().ExecuteIfBound(ControllerId, Key, Delta, RerouteResult);
+	if (GCommonBatchAxisInput)
+	{
+		AxisRerouteResults.Add(TPair<int32, FKey>(ControllerId, Key), RerouteResult.IsEventHandled());
+	}
+
 	if (RerouteResult.IsEventHandled())
 	{
 		return true;
@@ -91,12 +137,12 @@ bool UCommonGameViewportClient::InputTouch(FViewport* InViewport, int32 Controll
 
 void UCommonGameViewportClient::HandleRerouteInput(int32 ControllerId, FKey Key, EInputEvent EventType, FReply& Reply)
 {
-	ULocalPlayer* LocalPlayer = GameInstance->FindLocalPlayerFromControllerId(ControllerId);
 	Reply = FReply::Unhandled();
 
-	UCommonUIActionRouterBase* ActionRouter = LocalPlayer->GetSubsystem<UCommonUIActionRouterBase>();
-	if (ensure(ActionRouter))
+	if (UCommonUIActionRouterBase* ActionRouter = FindActionRouter(ControllerId))
 	{
+		FCommonInputLatencyTracker::FScopedKeyRouting LatencyRoutingScope(ControllerId, Key);
+
 		ERouteUIInputResult InputResult = ActionRouter->ProcessInput(Key, EventType);
 		if (InputResult == ERouteUIInputResult::BlockGameInput)
 		{
@@ -111,11 +157,9 @@ void UCommonGameViewportClient::HandleRerouteInput(int32 ControllerId, FKey Key,
 
 void UCommonGameViewportClient::HandleRerouteAxis(int32 ControllerId, FKey Key, float Delta, FReply& Reply)
 {
-	ULocalPlayer* LocalPlayer = GameInstance->FindLocalPlayerFromControllerId(ControllerId);
 	Reply = FReply::Unhandled();
 
-	UCommonUIActionRouterBase* ActionRouter = LocalPlayer->GetSubsystem<UCommonUIActionRouterBase>();
-	if (ensure(ActionRouter))
+	if (UCommonUIActionRouterBase* ActionRouter = FindActionRouter(ControllerId))
 	{
 		// We don't actually use axis inputs that reach the game viewport UI land for anything, we just want block them reaching the game when they shouldn't
 		if (!ActionRouter->CanProcessNormalGameInput())
@@ -127,7 +171,6 @@ void UCommonGameViewportClient::HandleRerouteAxis(int32 ControllerId, FKey Key,
 
 void UCommonGameViewportClient::HandleRerouteTouch(int32 ControllerId, uint32 TouchId, ETouchType::Type TouchType, const FVector2D& TouchLocation, FReply& Reply)
 {
-	ULocalPlayer* LocalPlayer = GameInstance->FindLocalPlayerFromControllerId(ControllerId);
 	Reply = FReply::Unhandled();
 
 	if (TouchId < EKeys::NUM_TOUCH_KEYS)
@@ -135,8 +178,7 @@ void UCommonGameViewportClient::HandleRerouteTouch(int32 ControllerId, uint32 To
 		FKey KeyPressed = EKeys::TouchKeys[TouchId];
 		if (KeyPressed.IsValid())
 		{
-			UCommonUIActionRouterBase* ActionRouter = LocalPlayer->GetSubsystem<UCommonUIActionRouterBase>();
-			if (ensure(ActionRouter))
+			if (UCommonUIActionRouterBase* ActionRouter = FindActionRouter(ControllerId))
 			{
 				//@todo DanH: Does anyone actually use this? Do we need to support holds or something with this?
 				EInputEvent SimilarInputEvent = IE_MAX;
@@ -162,6 +204,45 @@ void UCommonGameViewportClient::HandleRerouteTouch(int32 ControllerId, uint32 To
 	}
 }
 
+UCommonUIActionRouterBase* UCommonGameViewportClient::FindActionRouter(int32 ControllerId)
+{
+	if (ActionRoutersByControllerId.IsValidIndex(ControllerId))
+	{
+		// Controller ids can be reassigned without players coming or going, so make sure the player still has this one
+		const FCachedActionRouter& CachedRouter = ActionRoutersByControllerId[ControllerId];
+		const ULocalPlayer* LocalPlayer = CachedRouter.LocalPlayer.Get();
+		if (LocalPlayer && LocalPlayer->GetControllerId() == ControllerId)
+		{
+			return CachedRouter.ActionRouter.Get();
+		}
+	}
+
+	// Input can arrive from controllers no local player has, in which case there's simply no UI to route it to
+	ULocalPlayer* LocalPlayer = GameInstance ? GameInstance->FindLocalPlayerFromControllerId(ControllerId) : nullptr;
+	if (!LocalPlayer)
+	{
+		return nullptr;
+	}
+
+	UCommonUIActionRouterBase* ActionRouter = LocalPlayer->GetSubsystem<UCommonUIActionRouterBase>();
+	ensure(ActionRouter);
+
+	if (ControllerId >= 0)
+	{
+		if (ActionRoutersByControllerId.Num() <= ControllerId)
+		{
+			ActionRoutersByControllerId.SetNum(ControllerId + 1);
+		}
+		ActionRoutersByControllerId[ControllerId] = { LocalPlayer, ActionRouter };
+	}
+	return ActionRouter;
+}
+
+void UCommonGameViewportClient::HandlePlayerAddedOrRemoved(int32 PlayerIndex)
+{
+	ActionRoutersByControllerId.Reset();
+}
+
 bool UCommonGameViewportClient::IsKeyPriorityAboveUI(const FInputKeyEventArgs& EventArgs)
 {
 #if !UE_BUILD_SHIPPING
@@ -8,6 +8,10 @@
 #include "CommonUISettings.h"
 #include "Engine/Texture2DDynamic.h"
 #include "Widgets/Images/SImage.h"
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CommonLazyImage Streaming Complete"), STAT_CommonLazyImage_StreamingComplete, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonLazyImage Loads Completed"), STAT_CommonLazyImage_LoadsCompleted, STATGROUP_CommonUI);
 
 UCommonLazyImage::UCommonLazyImage(const FObjectInitializer& Initializer)
 	: Super(Initializer)
@@ -68,6 +72,10 @@ void UCommonLazyImage::OnImageStreamingStarted(TSoftObjectPtr<UObject> SoftObjec
 
 void UCommonLazyImage::OnImageStreamingComplete(TSoftObjectPtr<UObject> LoadedSoftObject)
 {
+	SCOPE_CYCLE_COUNTER(STAT_CommonLazyImage_StreamingComplete);
+	CSV_SCOPED_TIMING_STAT(CommonUI, LazyImageStreamingComplete);
+	INC_DWORD_STAT(STAT_CommonLazyImage_LoadsCompleted);
+
 	Super::OnImageStreamingComplete(LoadedSoftObject);
 
 	SetIsLoading(false);
@@ -4,6 +4,10 @@
 #include "CommonWidgetPaletteCategories.h"
 #include "CommonUISettings.h"
 #include "../Public/CommonActivatableWidget.h"
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CommonLazyWidget Streaming Complete"), STAT_CommonLazyWidget_StreamingComplete, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonLazyWidget Loads Completed"), STAT_CommonLazyWidget_LoadsCompleted, STATGROUP_CommonUI);
 
 UCommonLazyWidget::UCommonLazyWidget(const FObjectInitializer& Initializer)
 	: Super(Initializer)
@@ -167,6 +171,10 @@ void UCommonLazyWidget::RequestAsyncLoad(TSoftClassPtr<UObject> SoftObject, FStr
 					return; // Abort!
 				}
 
+				SCOPE_CYCLE_COUNTER(STAT_CommonLazyWidget_StreamingComplete);
+				CSV_SCOPED_TIMING_STAT(CommonUI, LazyWidgetStreamingComplete);
+				INC_DWORD_STAT(STAT_CommonLazyWidget_LoadsCompleted);
+
 				// Call the delegate to do whatever is needed, probably set the new image.
 				DelegateToCall.ExecuteIfBound();
 
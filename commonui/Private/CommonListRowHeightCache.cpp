@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CommonListRowHeightCache.h"
+
+void FCommonListRowHeightCache::Reset(int32 NumRows, float InitialRowHeight)
+{
+	RowHeights.Reset(NumRows);
+	RowHeights.AddUninitialized(NumRows);
+	for (float& RowHeight : RowHeights)
+	{
+		RowHeight = InitialRowHeight;
+	}
+	Reset(TArrayView<const float>(RowHeights));
+}
+
+void FCommonListRowHeightCache::Reset(TArrayView<const float> InRowHeights)
+{
+	if (InRowHeights.GetData() != RowHeights.GetData())
+	{
+		RowHeights = TArray<float>(InRowHeights.GetData(), InRowHeights.Num());
+	}
+
+	const int32 NumRows = RowHeights.Num();
+	Tree.Reset(NumRows + 1);
+	Tree.AddZeroed(NumRows + 1);
+
+	// Linear-time construction: each node pushes its partial sum up to its immediate parent.
+	for (int32 TreeIdx = 1; TreeIdx <= NumRows; ++TreeIdx)
+	{
+		Tree[TreeIdx] += RowHeights[TreeIdx - 1];
+		const int32 ParentIdx = TreeIdx + (TreeIdx & -TreeIdx);
+		if (ParentIdx <= NumRows)
+		{
+			Tree[ParentIdx] += Tree[TreeIdx];
+		}
+	}
+
+	HighestBit = NumRows > 0 ? (1 << FMath::FloorLog2(NumRows)) : 0;
+}
+
+void FCommonListRowHeightCache::SetRowHeight(int32 RowIndex, float NewHeight)
+{
+	if (!ensure(RowHeights.IsValidIndex(RowIndex)))
+	{
+		return;
+	}
+
+	const double Delta = (double)NewHeight - RowHeights[RowIndex];
+	if (Delta == 0.)
+	{
+		return;
+	}
+
+	RowHeights[RowIndex] = NewHeight;
+	for (int32 TreeIdx = RowIndex + 1; TreeIdx < Tree.Num(); TreeIdx += TreeIdx & -TreeIdx)
+	{
+		Tree[TreeIdx] += Delta;
+	}
+}
+
+double FCommonListRowHeightCache::GetOffsetOfRow(int32 RowIndex) const
+{
+	double Sum = 0.;
+	for (int32 TreeIdx = FMath::Clamp(RowIndex, 0, RowHeights.Num()); TreeIdx > 0; TreeIdx -= TreeIdx & -TreeIdx)
+	{
+		Sum += Tree[TreeIdx];
+	}
+	return Sum;
+}
+
+int32 FCommonListRowHeightCache::FindRowAtOffset(double Offset) const
+{
+	const int32 NumRows = RowHeights.Num();
+	if (NumRows == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// Binary descent through the tree to find the largest prefix whose sum is <= Offset
+	int32 Position = 0;
+	double Remaining = Offset;
+	for (int32 Step = HighestBit; Step > 0; Step >>= 1)
+	{
+		const int32 NextPosition = Position + Step;
+		if (NextPosition <= NumRows && Tree[NextPosition] <= Remaining)
+		{
+			Position = NextPosition;
+			Remaining -= Tree[NextPosition];
+		}
+	}
+
+	return FMath::Clamp(Position, 0, NumRows - 1);
+}
+
+double FCommonListRowHeightCache::SlateUnitsToItemOffset(double Offset) const
+{
+	const int32 RowIndex = FindRowAtOffset(Offset);
+	if (RowIndex == INDEX_NONE)
+	{
+		return 0.;
+	}
+
+	const float RowHeight = RowHeights[RowIndex];
+	const double OffsetIntoRow = Offset - GetOffsetOfRow(RowIndex);
+	return RowIndex + (RowHeight > 0.f ? FMath::Clamp(OffsetIntoRow / RowHeight, 0., 1.) : 0.);
+}
+
+double FCommonListRowHeightCache::ItemOffsetToSlateUnits(double ItemOffset) const
+{
+	const int32 NumRows = RowHeights.Num();
+	if (NumRows == 0 || ItemOffset <= 0.)
+	{
+		return 0.;
+	}
+
+	const int32 RowIndex = FMath::Min(FMath::FloorToInt(ItemOffset), NumRows);
+	if (RowIndex >= NumRows)
+	{
+		return GetTotalHeight();
+	}
+	return GetOffsetOfRow(RowIndex) + (ItemOffset - RowIndex) * RowHeights[RowIndex];
+}
@@ -3,7 +3,12 @@
 #include "CommonListView.h"
 #include "CommonWidgetPaletteCategories.h"
 #include "SCommonButtonTableRow.h"
+#include "CommonUIUtils.h"
 #include "CommonUIPrivatePCH.h"
+#include "CommonUIStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonListView Incremental Updates"), STAT_CommonListView_IncrementalUpdates, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonListView Entries Generated"), STAT_CommonListView_EntriesGenerated, STATGROUP_CommonUI);
 
 //////////////////////////////////////////////////////////////////////////
 // UCommonListView
@@ -28,13 +33,154 @@ const FText UCommonListView::GetPaletteCategory()
 }
 #endif
 
+void UCommonListView::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	MyCommonListView.Reset();
+}
+
 TSharedRef<STableViewBase> UCommonListView::RebuildListWidget()
 {
-	return ConstructListView<SCommonListView>();
+	MyCommonListView = ConstructListView<SCommonListView>();
+	if (bEnableVariableHeightEntries)
+	{
+		MyCommonListView->SetVariableHeightEntries(true, EstimatedEntryHeight, SCommonListView<UObject*>::FOnGetItemLayoutKey::CreateUObject(this, &UCommonListView::GetEntryLayoutKey));
+	}
+	return MyCommonListView.ToSharedRef();
+}
+
+uint32 UCommonListView::GetEntryLayoutKey(UObject* Item) const
+{
+	return OnGetEntryLayoutKeyDelegate.IsBound() ? OnGetEntryLayoutKeyDelegate.Execute(Item) : 0;
+}
+
+void UCommonListView::UpdateListItems(const TArray<UObject*>& NewListItems)
+{
+	if (NewListItems == ListItems)
+	{
+		return;
+	}
+
+	TArray<UObject*> AddedItems;
+	TArray<UObject*> RemovedItems;
+	CommonUIUtils::DiffListItems(ListItems, NewListItems, AddedItems, RemovedItems);
+	UpdateListItemsWithDiff(NewListItems, AddedItems, RemovedItems);
+}
+
+void UCommonListView::UpdateListItemsWithDiff(const TArray<UObject*>& NewListItems, const TArray<UObject*>& AddedItems, const TArray<UObject*>& RemovedItems)
+{
+	const FScrollAnchor ScrollAnchor = CaptureScrollAnchor();
+	ListItems = NewListItems;
+	FinishIncrementalUpdate(AddedItems, RemovedItems, ScrollAnchor);
+}
+
+void UCommonListView::InsertItemsAt(int32 Index, const TArray<UObject*>& ItemsToInsert)
+{
+	if (ItemsToInsert.Num() == 0)
+	{
+		return;
+	}
+
+	const FScrollAnchor ScrollAnchor = CaptureScrollAnchor();
+	ListItems.Insert(ItemsToInsert, FMath::Clamp(Index, 0, ListItems.Num()));
+	FinishIncrementalUpdate(ItemsToInsert, TArray<UObject*>(), ScrollAnchor);
+}
+
+void UCommonListView::RemoveItemsAt(int32 Index, int32 Count)
+{
+	if (Count <= 0 || !ListItems.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	Count = FMath::Min(Count, ListItems.Num() - Index);
+	const TArray<UObject*> RemovedItems(ListItems.GetData() + Index, Count);
+
+	const FScrollAnchor ScrollAnchor = CaptureScrollAnchor();
+	ListItems.RemoveAt(Index, Count);
+	FinishIncrementalUpdate(TArray<UObject*>(), RemovedItems, ScrollAnchor);
+}
+
+void UCommonListView::MoveItem(int32 FromIndex, int32 ToIndex)
+{
+	if (!ListItems.IsValidIndex(FromIndex) || !ListItems.IsValidIndex(ToIndex) || FromIndex == ToIndex)
+	{
+		return;
+	}
+
+	const FScrollAnchor ScrollAnchor = CaptureScrollAnchor();
+	UObject* MovedItem = ListItems[FromIndex];
+	ListItems.RemoveAt(FromIndex);
+	ListItems.Insert(MovedItem, ToIndex);
+	FinishIncrementalUpdate(TArray<UObject*>(), TArray<UObject*>(), ScrollAnchor);
+}
+
+void UCommonListView::ReplaceItemAt(int32 Index, UObject* NewItem)
+{
+	if (!ListItems.IsValidIndex(Index) || ListItems[Index] == NewItem)
+	{
+		return;
+	}
+
+	UObject* PreviousItem = ListItems[Index];
+	const FScrollAnchor ScrollAnchor = CaptureScrollAnchor();
+	ListItems[Index] = NewItem;
+
+	// The previous item may still be in the list at another index, in which case it wasn't removed
+	TArray<UObject*> RemovedItems;
+	if (!ListItems.Contains(PreviousItem))
+	{
+		RemovedItems.Add(PreviousItem);
+	}
+	FinishIncrementalUpdate({ NewItem }, RemovedItems, ScrollAnchor);
+}
+
+UCommonListView::FScrollAnchor UCommonListView::CaptureScrollAnchor() const
+{
+	FScrollAnchor ScrollAnchor;
+	if (MyListView.IsValid())
+	{
+		const float ScrollOffset = MyListView->GetScrollOffset();
+		const int32 AnchorIndex = FMath::FloorToInt(ScrollOffset);
+		if (ListItems.IsValidIndex(AnchorIndex))
+		{
+			ScrollAnchor.Item = ListItems[AnchorIndex];
+			ScrollAnchor.Fraction = ScrollOffset - AnchorIndex;
+		}
+	}
+	return ScrollAnchor;
+}
+
+void UCommonListView::FinishIncrementalUpdate(const TArray<UObject*>& AddedItems, const TArray<UObject*>& RemovedItems, const FScrollAnchor& ScrollAnchor)
+{
+	INC_DWORD_STAT(STAT_CommonListView_IncrementalUpdates);
+	NumEntriesGeneratedSinceLastUpdate = 0;
+
+	OnItemsChanged(AddedItems, RemovedItems);
+
+	if (MyListView.IsValid())
+	{
+		// Keep the entry that was at the top of the view in place, wherever it moved to in the item array
+		if (ScrollAnchor.Item)
+		{
+			const int32 NewAnchorIndex = ListItems.Find(ScrollAnchor.Item);
+			if (NewAnchorIndex != INDEX_NONE)
+			{
+				MyListView->SetScrollOffset(NewAnchorIndex + ScrollAnchor.Fraction);
+			}
+		}
+
+		// A refresh (rather than a rebuild) lets the list keep the entries of every item that is still present, along with the selection
+		MyListView->RequestListRefresh();
+	}
 }
 
 UUserWidget& UCommonListView::OnGenerateEntryWidgetInternal(UObject* Item, TSubclassOf<UUserWidget> DesiredEntryClass, const TSharedRef<STableViewBase>& OwnerTable)
 {
+	INC_DWORD_STAT(STAT_CommonListView_EntriesGenerated);
+	++NumEntriesGeneratedSinceLastUpdate;
+
 	if (DesiredEntryClass->IsChildOf<UCommonButtonBase>())
 	{
 		return GenerateTypedEntry<UUserWidget, SCommonButtonTableRow<UObject*>>(DesiredEntryClass, OwnerTable);
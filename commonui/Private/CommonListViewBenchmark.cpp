@@ -0,0 +1,347 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CommonListViewBenchmark.h"
+#include "CommonUIPrivatePCH.h"
+#include "CommonListView.h"
+#include "CommonTileView.h"
+#include "CommonTreeView.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/SizeBox.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+namespace CommonListViewBenchmark
+{
+	/** Fixed geometry the views are laid out in, roughly a 1080p screen */
+	static const FVector2D ViewSize(1920.f, 1080.f);
+	static const float FrameDeltaTime = 1.f / 60.f;
+
+	static const int32 MaxTraversalFrames = 2000;
+	static const int32 NumNavigations = 200;
+	static const int32 NumMutations = 100;
+	static const int32 NumTreeChildrenPerRoot = 9;
+
+	/** Size of the default entry, which is small enough for several to share a row in tile views */
+	static const FVector2D DefaultEntrySize(240.f, 64.f);
+
+	/** Bytes currently allocated under the UI tag, or INDEX_NONE if LLM isn't running */
+	int64 GetTaggedBytes()
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		if (FLowLevelMemTracker::IsEnabled())
+		{
+			// Tag totals are normally only gathered once per engine frame, and the whole benchmark runs within one
+			FLowLevelMemTracker::Get().UpdateStatsPerFrame();
+			return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, ELLMTag::UI);
+		}
+#endif
+		return INDEX_NONE;
+	}
+
+	double GetPercentile(const TArray<double>& SortedValues, float Percentile)
+	{
+		if (SortedValues.Num() == 0)
+		{
+			return 0.;
+		}
+		const int32 ValueIndex = FMath::Clamp(FMath::CeilToInt(Percentile * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+		return SortedValues[ValueIndex];
+	}
+}
+
+void UCommonListBenchmarkEntry::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	if (WidgetTree && !WidgetTree->RootWidget)
+	{
+		USizeBox* SizeBox = WidgetTree->ConstructWidget<USizeBox>();
+		SizeBox->SetWidthOverride(CommonListViewBenchmark::DefaultEntrySize.X);
+		SizeBox->SetHeightOverride(CommonListViewBenchmark::DefaultEntrySize.Y);
+		WidgetTree->RootWidget = SizeBox;
+	}
+}
+
+bool UCommonListViewBenchmark::Run(UWorld* World, const TArray<FString>& Args)
+{
+	FString EntryClassPath;
+	FString ItemCountsString = TEXT("1000,10000,100000");
+	FString ViewTypesString = TEXT("List,Tile,Tree");
+	for (const FString& Arg : Args)
+	{
+		FParse::Value(*Arg, TEXT("EntryClass="), EntryClassPath);
+		FParse::Value(*Arg, TEXT("Items="), ItemCountsString, false);
+		FParse::Value(*Arg, TEXT("Views="), ViewTypesString, false);
+	}
+
+	UClass* EntryClass = EntryClassPath.IsEmpty() ? UCommonListBenchmarkEntry::StaticClass() : LoadClass<UUserWidget>(nullptr, *EntryClassPath);
+	if (!World || !EntryClass)
+	{
+		UE_LOG(LogCommonUI, Error, TEXT("CommonUI.BenchmarkListViews requires a world, and EntryClass= (if given) must be a user widget class implementing UserListEntry"));
+		return false;
+	}
+
+	if (CommonListViewBenchmark::GetTaggedBytes() == INDEX_NONE)
+	{
+		UE_LOG(LogCommonUI, Display, TEXT("List view benchmark: memory is only measured with LLM running (-llm)"));
+	}
+
+	TArray<FString> ItemCountStrings;
+	ItemCountsString.ParseIntoArray(ItemCountStrings, TEXT(","));
+	TArray<FString> ViewTypes;
+	ViewTypesString.ParseIntoArray(ViewTypes, TEXT(","));
+
+	FClassProperty* EntryClassProperty = FindFProperty<FClassProperty>(UListViewBase::StaticClass(), TEXT("EntryWidgetClass"));
+	if (!ensure(EntryClassProperty))
+	{
+		return false;
+	}
+
+	for (const FString& ViewType : ViewTypes)
+	{
+		UClass* ViewClass = ViewType == TEXT("Tile") ? UCommonTileView::StaticClass() : ViewType == TEXT("Tree") ? UCommonTreeView::StaticClass() : UCommonListView::StaticClass();
+		for (const FString& ItemCountString : ItemCountStrings)
+		{
+			const int32 NumItems = FCString::Atoi(*ItemCountString);
+			if (NumItems <= 0)
+			{
+				continue;
+			}
+
+			UListView* View = NewObject<UListView>(World, ViewClass, NAME_None, RF_Transient);
+			EntryClassProperty->SetObjectPropertyValue_InContainer(View, EntryClass);
+			View->OnEntryWidgetGenerated().AddUObject(this, &UCommonListViewBenchmark::HandleEntryGenerated);
+
+			UE_LOG(LogCommonUI, Display, TEXT("List view benchmark: %s, %d items"), *ViewClass->GetName(), NumItems);
+			RunScenarios(*View, NumItems);
+
+			View->ReleaseSlateResources(true);
+			View->MarkPendingKill();
+			AllItems.Reset();
+		}
+	}
+	return true;
+}
+
+void UCommonListViewBenchmark::RunScenarios(UListView& View, int32 NumItems)
+{
+	using namespace CommonListViewBenchmark;
+
+	// Everything allocated while the views are exercised is attributed to the UI tag, which is what the scenarios measure
+	LLM_SCOPE(ELLMTag::UI);
+
+	// The same seed for every run so the targets are identical between runs
+	FRandomStream RandomStream(NumItems);
+
+	AllItems.Reset(NumItems);
+	TArray<UObject*> RootItems;
+	UTreeView* TreeView = Cast<UTreeView>(&View);
+	for (int32 ItemIdx = 0; ItemIdx < NumItems; ++ItemIdx)
+	{
+		UCommonListBenchmarkItem* Item = NewObject<UCommonListBenchmarkItem>(this);
+		AllItems.Add(Item);
+
+		// Trees get a root for every few items, with the items in between as its children
+		if (TreeView && RootItems.Num() > 0 && ItemIdx % (NumTreeChildrenPerRoot + 1) != 0)
+		{
+			CastChecked<UCommonListBenchmarkItem>(RootItems.Last())->Children.Add(Item);
+		}
+		else
+		{
+			RootItems.Add(Item);
+		}
+	}
+
+	if (TreeView)
+	{
+		TreeView->SetOnGetItemChildren(this, &UCommonListViewBenchmark::GetItemChildren);
+	}
+
+	TSharedRef<STableViewBase> TableView = StaticCastSharedRef<STableViewBase>(View.TakeWidget());
+
+	BeginScenario(TEXT("InitialGeneration"));
+	{
+		View.SetListItems(RootItems);
+		if (TreeView)
+		{
+			for (UObject* RootItem : RootItems)
+			{
+				TreeView->SetItemExpansion(RootItem, true);
+			}
+		}
+		TickFrame(*TableView);
+		TickFrame(*TableView);
+	}
+	EndScenario();
+
+	BeginScenario(TEXT("ScrollTraversal"));
+	{
+		const float ScrollStep = FMath::Max(1.f, (float)NumItems / MaxTraversalFrames);
+		float LastScrollOffset = -1.f;
+		for (int32 FrameIdx = 0; FrameIdx < MaxTraversalFrames; ++FrameIdx)
+		{
+			TableView->SetScrollOffset((FrameIdx + 1) * ScrollStep);
+			TickFrame(*TableView);
+
+			// Stop once the view refuses to scroll any further
+			const float ScrollOffset = TableView->GetScrollOffset();
+			if (FMath::IsNearlyEqual(ScrollOffset, LastScrollOffset))
+			{
+				break;
+			}
+			LastScrollOffset = ScrollOffset;
+		}
+		TableView->SetScrollOffset(0.f);
+		TickFrame(*TableView);
+	}
+	EndScenario();
+
+	BeginScenario(TEXT("NavigateToRandomItem"));
+	for (int32 NavigationIdx = 0; NavigationIdx < NumNavigations; ++NavigationIdx)
+	{
+		View.RequestNavigateToItem(AllItems[RandomStream.RandRange(0, NumItems - 1)]);
+		TickFrame(*TableView);
+		TickFrame(*TableView);
+	}
+	EndScenario();
+
+	BeginScenario(TEXT("FocusScrollToSelection"));
+	for (int32 NavigationIdx = 0; NavigationIdx < NumNavigations; ++NavigationIdx)
+	{
+		View.SetSelectedItem(AllItems[RandomStream.RandRange(0, NumItems - 1)]);
+		TableView->OnFocusReceived(FGeometry::MakeRoot(ViewSize, FSlateLayoutTransform()), FFocusEvent(EFocusCause::Navigation));
+		TickFrame(*TableView);
+		TickFrame(*TableView);
+	}
+	EndScenario();
+
+	BeginScenario(TEXT("IncrementalMutation"));
+	for (int32 MutationIdx = 0; MutationIdx < NumMutations; ++MutationIdx)
+	{
+		const bool bInsert = MutationIdx % 2 == 0;
+		UCommonListView* CommonListView = Cast<UCommonListView>(&View);
+		if (CommonListView)
+		{
+			const int32 MutationIndex = RandomStream.RandRange(0, CommonListView->GetNumItems() - 1);
+			if (bInsert)
+			{
+				CommonListView->InsertItemsAt(MutationIndex, { NewObject<UCommonListBenchmarkItem>(this) });
+			}
+			else
+			{
+				CommonListView->RemoveItemsAt(MutationIndex);
+			}
+		}
+		else if (bInsert)
+		{
+			UObject* NewItem = NewObject<UCommonListBenchmarkItem>(this);
+			AllItems.Add(NewItem);
+			View.AddItem(NewItem);
+		}
+		else
+		{
+			View.RemoveItem(View.GetListItems().Last());
+		}
+		TickFrame(*TableView);
+	}
+	EndScenario();
+}
+
+void UCommonListViewBenchmark::BeginScenario(const TCHAR* ScenarioName)
+{
+	using namespace CommonListViewBenchmark;
+
+	CurrentScenario = FScenarioResult();
+	CurrentScenario.Name = ScenarioName;
+	ScenarioStartTaggedBytes = GetTaggedBytes();
+}
+
+void UCommonListViewBenchmark::EndScenario()
+{
+	using namespace CommonListViewBenchmark;
+
+	const int64 TaggedBytes = GetTaggedBytes();
+	CurrentScenario.TaggedBytes = TaggedBytes != INDEX_NONE ? TaggedBytes - ScenarioStartTaggedBytes : 0;
+
+	TArray<double> SortedFrameTimes = CurrentScenario.FrameTimes;
+	SortedFrameTimes.Sort();
+
+	UE_LOG(LogCommonUI, Display, TEXT("    %-24s frames: %5d  p50: %7.3fms  p90: %7.3fms  p99: %7.3fms  max: %7.3fms  entries generated: %6d  UI bytes allocated: %lld"),
+		*CurrentScenario.Name,
+		SortedFrameTimes.Num(),
+		GetPercentile(SortedFrameTimes, 0.5f) * 1000.,
+		GetPercentile(SortedFrameTimes, 0.9f) * 1000.,
+		GetPercentile(SortedFrameTimes, 0.99f) * 1000.,
+		GetPercentile(SortedFrameTimes, 1.f) * 1000.,
+		CurrentScenario.NumEntriesGenerated,
+		CurrentScenario.TaggedBytes);
+}
+
+void UCommonListViewBenchmark::TickFrame(STableViewBase& TableView)
+{
+	using namespace CommonListViewBenchmark;
+
+	const FGeometry ViewGeometry = FGeometry::MakeRoot(ViewSize, FSlateLayoutTransform());
+
+	const double StartTime = FPlatformTime::Seconds();
+	CurrentTime += FrameDeltaTime;
+	TableView.SlatePrepass(1.f);
+	TableView.Tick(ViewGeometry, CurrentTime, FrameDeltaTime);
+	CurrentScenario.FrameTimes.Add(FPlatformTime::Seconds() - StartTime);
+}
+
+void UCommonListViewBenchmark::GetItemChildren(UObject* Item, TArray<UObject*>& OutChildren)
+{
+	if (UCommonListBenchmarkItem* BenchmarkItem = Cast<UCommonListBenchmarkItem>(Item))
+	{
+		OutChildren = BenchmarkItem->Children;
+	}
+}
+
+void UCommonListViewBenchmark::HandleEntryGenerated(UUserWidget& EntryWidget)
+{
+	++CurrentScenario.NumEntriesGenerated;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkListViewsCommand(
+	TEXT("CommonUI.BenchmarkListViews"),
+	TEXT("Benchmarks common list, tile and tree views with large item counts. Args: [EntryClass=<class path>] [Items=1000,10000,100000] [Views=List,Tile,Tree]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UCommonListViewBenchmark* Benchmark = NewObject<UCommonListViewBenchmark>(GetTransientPackage());
+			Benchmark->AddToRoot();
+			Benchmark->Run(World, Args);
+			Benchmark->RemoveFromRoot();
+		}));
+#endif
+
+#if WITH_DEV_AUTOMATION_TESTS
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommonListViewBenchmarkTest, "System.CommonUI.ListViewBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FCommonListViewBenchmarkTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = nullptr;
+	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+	{
+		if (WorldContext.World() && (!World || WorldContext.WorldType == EWorldType::Game || WorldContext.WorldType == EWorldType::PIE))
+		{
+			World = WorldContext.World();
+		}
+	}
+
+	// The largest count is left to the console command, it takes too long for every automation pass
+	TArray<FString> Args;
+	Args.Add(TEXT("Items=1000,10000"));
+
+	UCommonListViewBenchmark* Benchmark = NewObject<UCommonListViewBenchmark>(GetTransientPackage());
+	Benchmark->AddToRoot();
+	const bool bSucceeded = Benchmark->Run(World, Args);
+	Benchmark->RemoveFromRoot();
+
+	TestTrue(TEXT("List view benchmark ran"), bSucceeded);
+	return true;
+}
+#endif
@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "CommonListViewBenchmark.generated.h"
+
+class UListView;
+class STableViewBase;
+
+/** Bare item used to populate the views being benchmarked */
+UCLASS(Transient)
+class UCommonListBenchmarkItem : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TArray<UObject*> Children;
+};
+
+/** Fixed-size entry used when no EntryClass is given, so the benchmark can run without any content */
+UCLASS(Transient)
+class UCommonListBenchmarkEntry : public UUserWidget, public IUserObjectListEntry
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void NativeOnInitialized() override;
+};
+
+/**
+ * Puts list, tile and tree views through a fixed set of scenarios with a large number of synthetic items and logs
+ * frame time percentiles, entries generated and memory allocated for each scenario. Item order, navigation targets and
+ * mutations are all seeded, so runs with the same arguments are comparable.
+ *
+ * Memory is what the scenario allocated under the LLM UI tag (run with -llm), so other systems don't pollute it.
+ *
+ * Runs as the System.CommonUI.ListViewBenchmark automation test with the default entry, or on demand with:
+ * CommonUI.BenchmarkListViews [EntryClass=/Game/UI/W_Entry.W_Entry_C] [Items=1000,10000,100000] [Views=List,Tile,Tree]
+ */
+UCLASS(Transient)
+class UCommonListViewBenchmark : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** @return False if the arguments couldn't be used */
+	bool Run(UWorld* World, const TArray<FString>& Args);
+
+private:
+	struct FScenarioResult
+	{
+		FString Name;
+		TArray<double> FrameTimes;
+		int32 NumEntriesGenerated = 0;
+		int64 TaggedBytes = 0;
+	};
+
+	void RunScenarios(UListView& View, int32 NumItems);
+
+	void BeginScenario(const TCHAR* ScenarioName);
+	void EndScenario();
+	void TickFrame(STableViewBase& TableView);
+
+	void GetItemChildren(UObject* Item, TArray<UObject*>& OutChildren);
+	void HandleEntryGenerated(UUserWidget& EntryWidget);
+
+	UPROPERTY()
+	TArray<UObject*> AllItems;
+
+	FScenarioResult CurrentScenario;
+	int64 ScenarioStartTaggedBytes = 0;
+	double CurrentTime = 0.;
+};
@@ -24,6 +24,10 @@
 #include "Types/ReflectionMetadata.h"
 #include "Framework/Text/IRichTextMarkupWriter.h"
 #include "Framework/Text/RichTextMarkupProcessing.h"
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CommonRichTextBlock Decorate"), STAT_CommonRichTextBlock_Decorate, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonRichTextBlock Runs Decorated"), STAT_CommonRichTextBlock_RunsDecorated, STATGROUP_CommonUI);
 
 namespace SupportedMarkupKeys
 {
@@ -68,6 +72,10 @@ public:
 
 	virtual TSharedRef<ISlateRun> Create(const TSharedRef<class FTextLayout>& TextLayout, const FTextRunParseResults& RunParseResult, const FString& OriginalText, const TSharedRef<FString>& InOutModelText, const ISlateStyle* Style) override final
 	{
+		SCOPE_CYCLE_COUNTER(STAT_CommonRichTextBlock_Decorate);
+		CSV_SCOPED_TIMING_STAT(CommonUI, RichTextDecorate);
+		INC_DWORD_STAT(STAT_CommonRichTextBlock_RunsDecorated);
+
 		FTextRange ModelRange;
 		ModelRange.BeginIndex = InOutModelText->Len();
 
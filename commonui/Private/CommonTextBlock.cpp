@@ -9,9 +9,25 @@
 #include "Widgets/Text/STextBlock.h"
 #include "Layout/LayoutUtils.h"
 #include "Types/ReflectionMetadata.h"
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("STextScroller OnScrollTextTick"), STAT_STextScroller_OnScrollTextTick, STATGROUP_CommonUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("STextScroller Instances"), STAT_STextScroller_Instances, STATGROUP_CommonUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("STextScroller Active Timers"), STAT_STextScroller_ActiveTimers, STATGROUP_CommonUI);
+
+STextScroller::~STextScroller()
+{
+	DEC_DWORD_STAT(STAT_STextScroller_Instances);
+	if (ActiveTimerHandle.IsValid())
+	{
+		DEC_DWORD_STAT(STAT_STextScroller_ActiveTimers);
+	}
+}
 
 void STextScroller::Construct(const FArguments& InArgs)
 {
+	INC_DWORD_STAT(STAT_STextScroller_Instances);
+
 	ScrollStyle = InArgs._ScrollStyle;
 	ensure(ScrollStyle.IsValid());
 
@@ -78,6 +94,7 @@ void STextScroller::UpdateTickability(const FGeometry& AllottedGeometry)
 		if (!ActiveTimerHandle.IsValid())
 		{
 			ActiveTimerHandle = RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &STextScroller::OnScrollTextTick));
+			INC_DWORD_STAT(STAT_STextScroller_ActiveTimers);
 			// If we need to scroll, then it's imperative that we arrange from the left, rather than fill, so that we flip to right aligning and scrolling
 			// to the right (potentially).
 			SetFlowDirectionPreference(EFlowDirectionPreference::Culture);
@@ -88,6 +105,7 @@ void STextScroller::UpdateTickability(const FGeometry& AllottedGeometry)
 	{
 		UnRegisterActiveTimer(ActiveTimerHandle.ToSharedRef());
 		ActiveTimerHandle.Reset();
+		DEC_DWORD_STAT(STAT_STextScroller_ActiveTimers);
 		ResetScrollState();
 
 		// If we no longer need to scroll, just inherit the flow direction.
@@ -98,7 +116,8 @@ void STextScroller::UpdateTickability(const FGeometry& AllottedGeometry)
 
 EActiveTimerReturnType STextScroller::OnScrollTextTick(double CurrentTime, float DeltaTime)
 {
-	QUICK_SCOPE_CYCLE_COUNTER(STAT_UCommonTextBlock_OnTick);
+	SCOPE_CYCLE_COUNTER(STAT_STextScroller_OnScrollTextTick);
+	CSV_SCOPED_TIMING_STAT(CommonUI, TextScrollerTick);
 
 	const UCommonTextScrollStyle* TextScrollStyle = ScrollStyle.Get();
 	check(TextScrollStyle);
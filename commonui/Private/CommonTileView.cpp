@@ -3,6 +3,11 @@
 #include "CommonTileView.h"
 #include "CommonUIPrivatePCH.h"
 #include "SCommonButtonTableRow.h"
+#include "CommonUIUtils.h"
+#include "Containers/Ticker.h"
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CommonTileView TickProgressiveGeneration"), STAT_CommonTileView_TickProgressiveGeneration, STATGROUP_CommonUI);
 
 ///////////////////////
 // SCommonTileView
@@ -68,6 +73,24 @@ public:
 		return STileView<ItemType>::OnTouchEnded(MyGeometry, InTouchEvent);
 	}
 
+	/** Discards the generated rows of the given items so that they are generated again on the next refresh */
+	void RegenerateItemRows(const TArray<ItemType>& Items)
+	{
+		for (const ItemType& Item : Items)
+		{
+			if (const TSharedRef<ITableRow>* ExistingRow = this->WidgetGenerator.ItemToWidgetMap.Find(Item))
+			{
+				const TSharedRef<ITableRow> RowToRelease = *ExistingRow;
+				this->WidgetGenerator.ItemToWidgetMap.Remove(Item);
+				this->WidgetGenerator.WidgetMapToItem.Remove(&RowToRelease.Get());
+
+				RowToRelease->ResetRow();
+				this->OnRowReleased.ExecuteIfBound(RowToRelease);
+			}
+		}
+		this->RequestListRefresh();
+	}
+
 private:
 	bool bScrollToSelectedOnFocus = true;
 };
@@ -83,16 +106,237 @@ UCommonTileView::UCommonTileView(const FObjectInitializer& ObjectInitializer)
 	bEnableScrollAnimation = true;
 }
 
+void UCommonTileView::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	MyCommonTileView.Reset();
+	PendingItems.Reset();
+	ItemsBeingGenerated.Reset();
+
+	if (ProgressiveGenerationTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(ProgressiveGenerationTickerHandle);
+		ProgressiveGenerationTickerHandle.Reset();
+	}
+}
+
+void UCommonTileView::UpdateListItems(const TArray<UObject*>& NewListItems)
+{
+	if (NewListItems == ListItems)
+	{
+		return;
+	}
+
+	TArray<UObject*> AddedItems;
+	TArray<UObject*> RemovedItems;
+	CommonUIUtils::DiffListItems(ListItems, NewListItems, AddedItems, RemovedItems);
+	UpdateListItemsWithDiff(NewListItems, AddedItems, RemovedItems);
+}
+
+void UCommonTileView::UpdateListItemsWithDiff(const TArray<UObject*>& NewListItems, const TArray<UObject*>& AddedItems, const TArray<UObject*>& RemovedItems)
+{
+	ListItems = NewListItems;
+	OnItemsChanged(AddedItems, RemovedItems);
+
+	if (MyListView.IsValid())
+	{
+		// A refresh (rather than a rebuild) lets the tiles of every item that is still present be kept, along with the selection
+		MyListView->RequestListRefresh();
+	}
+}
+
 TSharedRef<STableViewBase> UCommonTileView::RebuildListWidget()
 {
-	return ConstructTileView<SCommonTileView>();
+	MyCommonTileView = ConstructTileView<SCommonTileView>();
+	return MyCommonTileView.ToSharedRef();
 }
 
 UUserWidget& UCommonTileView::OnGenerateEntryWidgetInternal(UObject* Item, TSubclassOf<UUserWidget> DesiredEntryClass, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	const int32 ItemIndex = bEnableProgressiveGeneration ? FindItemIndex(Item) : INDEX_NONE;
+	if (ShouldGeneratePlaceholder(Item, ItemIndex))
+	{
+		PendingItems.Add(Item, ItemIndex);
+		if (!ProgressiveGenerationTickerHandle.IsValid())
+		{
+			ProgressiveGenerationTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCommonTileView::TickProgressiveGeneration));
+		}
+		return GenerateTypedEntry(PlaceholderEntryClass, OwnerTable);
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	UUserWidget& EntryWidget = GenerateEntry(DesiredEntryClass, OwnerTable);
+	const double GenerationTime = FPlatformTime::Seconds() - StartTime;
+
+	BudgetSpentThisFrame += GenerationTime;
+	AverageEntryGenerationTime = AverageEntryGenerationTime > 0. ? FMath::Lerp(AverageEntryGenerationTime, GenerationTime, 0.1) : GenerationTime;
+
+	return EntryWidget;
+}
+
+UUserWidget& UCommonTileView::GenerateEntry(TSubclassOf<UUserWidget> DesiredEntryClass, const TSharedRef<STableViewBase>& OwnerTable)
 {
 	if (DesiredEntryClass->IsChildOf<UCommonButtonBase>())
 	{
 		return GenerateTypedEntry<UUserWidget, SCommonButtonTableRow<UObject*>>(DesiredEntryClass, OwnerTable);
 	}
 	return GenerateTypedEntry(DesiredEntryClass, OwnerTable);
+}
+
+bool UCommonTileView::ShouldGeneratePlaceholder(UObject* Item, int32 ItemIndex)
+{
+	if (!bEnableProgressiveGeneration || !PlaceholderEntryClass || IsDesignTime())
+	{
+		return false;
+	}
+
+	if (ItemsBeingGenerated.Remove(Item) > 0)
+	{
+		return false;
+	}
+
+	if (BudgetFrameNumber != GFrameCounter)
+	{
+		BudgetFrameNumber = GFrameCounter;
+		BudgetSpentThisFrame = 0.;
+		BudgetAnchorIndex = GetGenerationAnchorIndex();
+
+		// Work out how far from the anchor tile we can afford to go this frame, given what entries have cost so far
+		const int32 AffordableTiles = AverageEntryGenerationTime > 0. ? FMath::FloorToInt((GenerationBudgetMs / 1000.) / AverageEntryGenerationTime) : MAX_int32;
+		BudgetRadius = AffordableTiles == MAX_int32 ? MAX_int32 : FMath::Max(0, FMath::FloorToInt((FMath::Sqrt((float)AffordableTiles) - 1.f) * 0.5f));
+	}
+
+	if (BudgetSpentThisFrame * 1000. >= GenerationBudgetMs)
+	{
+		return true;
+	}
+
+	return BudgetRadius != MAX_int32 && GetTileDistance(ItemIndex, BudgetAnchorIndex, GetNumItemsPerLine()) > BudgetRadius;
+}
+
+bool UCommonTileView::TickProgressiveGeneration(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CommonTileView_TickProgressiveGeneration);
+
+	// Anything we asked for last frame has been generated by now, or has scrolled out of view
+	ItemsBeingGenerated.Reset();
+
+	// Indices only go stale when the list items change, in which case they're all looked up again in one pass
+	TMap<UObject*, int32> ItemIndicesIfStale;
+	for (auto PendingIt = PendingItems.CreateIterator(); PendingIt; ++PendingIt)
+	{
+		UObject* PendingItem = PendingIt.Key().Get();
+		if (!PendingItem || !MyListView.IsValid() || !MyListView->WidgetFromItem(PendingItem).IsValid())
+		{
+			PendingIt.RemoveCurrent();
+			continue;
+		}
+
+		int32& ItemIndex = PendingIt.Value();
+		if (!ListItems.IsValidIndex(ItemIndex) || ListItems[ItemIndex] != PendingItem)
+		{
+			if (ItemIndicesIfStale.Num() == 0)
+			{
+				ItemIndicesIfStale.Reserve(ListItems.Num());
+				for (int32 ListIdx = 0; ListIdx < ListItems.Num(); ++ListIdx)
+				{
+					ItemIndicesIfStale.Add(ListItems[ListIdx], ListIdx);
+				}
+			}
+
+			const int32* FoundIndex = ItemIndicesIfStale.Find(PendingItem);
+			ItemIndex = FoundIndex ? *FoundIndex : INDEX_NONE;
+		}
+	}
+
+	if (PendingItems.Num() == 0 || !MyCommonTileView.IsValid())
+	{
+		PendingItems.Reset();
+		ProgressiveGenerationTickerHandle.Reset();
+		OnProgressiveGenerationComplete.Broadcast(this);
+		return false;
+	}
+
+	// Replace the placeholders nearest the anchor first
+	const int32 AnchorIndex = GetGenerationAnchorIndex();
+	const int32 NumItemsPerLine = GetNumItemsPerLine();
+
+	TArray<TPair<int32, UObject*>> PendingByDistance;
+	PendingByDistance.Reserve(PendingItems.Num());
+	for (const TPair<TWeakObjectPtr<UObject>, int32>& PendingItem : PendingItems)
+	{
+		PendingByDistance.Emplace(GetTileDistance(PendingItem.Value, AnchorIndex, NumItemsPerLine), PendingItem.Key.Get());
+	}
+	PendingByDistance.Sort([](const TPair<int32, UObject*>& A, const TPair<int32, UObject*>& B) { return A.Key < B.Key; });
+
+	const int32 BatchSize = AverageEntryGenerationTime > 0. ? FMath::Clamp(FMath::FloorToInt((GenerationBudgetMs / 1000.) / AverageEntryGenerationTime), 1, PendingByDistance.Num()) : 1;
+
+	TArray<UObject*> ItemsToGenerate;
+	ItemsToGenerate.Reserve(BatchSize);
+	for (int32 BatchIdx = 0; BatchIdx < BatchSize; ++BatchIdx)
+	{
+		UObject* Item = PendingByDistance[BatchIdx].Value;
+		ItemsToGenerate.Add(Item);
+		ItemsBeingGenerated.Add(Item);
+		PendingItems.Remove(Item);
+	}
+
+	MyCommonTileView->RegenerateItemRows(ItemsToGenerate);
+	return true;
+}
+
+int32 UCommonTileView::FindItemIndex(UObject* Item)
+{
+	// Tiles are generated in order, so the item is usually right after the last one we looked up
+	for (int32 Offset = 0; Offset < 2; ++Offset)
+	{
+		const int32 HintIndex = LastFoundItemIndex + Offset;
+		if (ListItems.IsValidIndex(HintIndex) && ListItems[HintIndex] == Item)
+		{
+			LastFoundItemIndex = HintIndex;
+			return HintIndex;
+		}
+	}
+
+	const int32 ItemIndex = ListItems.IndexOfByKey(Item);
+	LastFoundItemIndex = FMath::Max(ItemIndex, 0);
+	return ItemIndex;
+}
+
+int32 UCommonTileView::GetNumItemsPerLine() const
+{
+	const float EntryWidth = GetEntryWidth();
+	if (!MyListView.IsValid() || EntryWidth <= 0.f)
+	{
+		return 1;
+	}
+	return FMath::Max(1, FMath::FloorToInt(MyListView->GetCachedGeometry().GetLocalSize().X / EntryWidth));
+}
+
+int32 UCommonTileView::GetGenerationAnchorIndex() const
+{
+	if (UObject* SelectedItem = GetSelectedItem())
+	{
+		const int32 SelectedIndex = ListItems.IndexOfByKey(SelectedItem);
+		if (SelectedIndex != INDEX_NONE && MyListView.IsValid() && MyListView->WidgetFromItem(SelectedItem).IsValid())
+		{
+			return SelectedIndex;
+		}
+	}
+
+	// Otherwise the first visible tile
+	return MyListView.IsValid() ? FMath::FloorToInt(MyListView->GetScrollOffset()) * GetNumItemsPerLine() : 0;
+}
+
+int32 UCommonTileView::GetTileDistance(int32 ItemIndexA, int32 ItemIndexB, int32 NumItemsPerLine) const
+{
+	if (ItemIndexA == INDEX_NONE || ItemIndexB == INDEX_NONE)
+	{
+		return MAX_int32;
+	}
+
+	const int32 LineDistance = FMath::Abs(ItemIndexA / NumItemsPerLine - ItemIndexB / NumItemsPerLine);
+	const int32 ColumnDistance = FMath::Abs(ItemIndexA % NumItemsPerLine - ItemIndexB % NumItemsPerLine);
+	return FMath::Max(LineDistance, ColumnDistance);
 }
\ No newline at end of file
@@ -10,9 +10,48 @@ UCommonTreeView::UCommonTreeView(const FObjectInitializer& ObjectInitializer)
 	bEnableScrollAnimation = true;
 }
 
+void UCommonTreeView::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	MyCommonTreeView.Reset();
+}
+
 TSharedRef<STableViewBase> UCommonTreeView::RebuildListWidget()
 {
-	return ConstructTreeView<SCommonTreeView>();
+	MyCommonTreeView = ConstructTreeView<SCommonTreeView>();
+	if (bUseFlattenedTree)
+	{
+		// Only route requests through us if someone is listening, otherwise every item would be asked about (and assumed to have) children
+		TCommonFlattenedTree<UObject*>::FOnRequestChildrenAsync RequestChildrenAsyncDelegate;
+		if (OnRequestItemChildrenAsyncDelegate.IsBound())
+		{
+			RequestChildrenAsyncDelegate.BindUObject(this, &UCommonTreeView::HandleRequestItemChildrenAsync);
+		}
+		MyCommonTreeView->EnableFlattenedTree(RequestChildrenAsyncDelegate);
+	}
+	return MyCommonTreeView.ToSharedRef();
+}
+
+void UCommonTreeView::AppendItemChildren(UObject* Item, const TArray<UObject*>& Children, bool bIsFinalBatch)
+{
+	if (MyCommonTreeView.IsValid())
+	{
+		MyCommonTreeView->AppendItemChildren(Item, Children, bIsFinalBatch);
+	}
+}
+
+void UCommonTreeView::InvalidateItemChildren(UObject* Item)
+{
+	if (MyCommonTreeView.IsValid())
+	{
+		MyCommonTreeView->InvalidateItemChildren(Item);
+	}
+}
+
+bool UCommonTreeView::HandleRequestItemChildrenAsync(UObject* Item)
+{
+	return OnRequestItemChildrenAsyncDelegate.IsBound() && OnRequestItemChildrenAsyncDelegate.Execute(Item);
 }
 
 UUserWidget& UCommonTreeView::OnGenerateEntryWidgetInternal(UObject* Item, TSubclassOf<UUserWidget> DesiredEntryClass, const TSharedRef<STableViewBase>& OwnerTable)
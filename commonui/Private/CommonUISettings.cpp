@@ -8,6 +8,7 @@
 UCommonUISettings::UCommonUISettings(const FObjectInitializer& Initializer)
 	: Super(Initializer)
 	, bAutoLoadData(true)
+	, MaxConcurrentVideoDecoders(4)
 	, bDefaultDataLoaded(false)
 {}
 
@@ -15,7 +15,14 @@
 #include "UObject/UObjectIterator.h"
 #include "Input/CommonUIActionRouterBase.h"
 #include "Engine/LocalPlayer.h"
+#include "CommonUISettings.h"
+#include "MediaPlayer.h"
+#include "MediaSoundComponent.h"
+#include "CommonUIStats.h"
 
+DECLARE_CYCLE_STAT(TEXT("CommonUISubsystem GetInputActionButtonIcon"), STAT_CommonUISubsystem_GetInputActionButtonIcon, STATGROUP_CommonUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CommonVideoPlayer Decoders In Use"), STAT_CommonVideoPlayer_DecodersInUse, STATGROUP_CommonUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CommonVideoPlayer Decoders Pooled"), STAT_CommonVideoPlayer_DecodersPooled, STATGROUP_CommonUI);
 
 UCommonUISubsystemBase* UCommonUISubsystemBase::Get(const UWidget& Widget)
 {
@@ -32,6 +39,22 @@ void UCommonUISubsystemBase::Initialize(FSubsystemCollectionBase& Collection)
 	CommonUI::SetupStyles();
 }
 
+void UCommonUISubsystemBase::Deinitialize()
+{
+	for (FCommonVideoPlayerResources& Resources : VideoResourcesInUse)
+	{
+		ResetVideoResources(Resources);
+	}
+	DEC_DWORD_STAT_BY(STAT_CommonVideoPlayer_DecodersInUse, VideoResourcesInUse.Num());
+	DEC_DWORD_STAT_BY(STAT_CommonVideoPlayer_DecodersPooled, IdleVideoResources.Num());
+
+	VideoResourcesInUse.Reset();
+	IdleVideoResources.Reset();
+	VideoResourcesRequests.Reset();
+
+	Super::Deinitialize();
+}
+
 void UCommonUISubsystemBase::SetAnalyticProvider(const TSharedPtr<IAnalyticsProviderET>& AnalyticProvider)
 {
 	AnalyticProviderWeakPtr = AnalyticProvider;
@@ -39,6 +62,9 @@ void UCommonUISubsystemBase::SetAnalyticProvider(const TSharedPtr<IAnalyticsProv
 
 FSlateBrush UCommonUISubsystemBase::GetInputActionButtonIcon(const FDataTableRowHandle& InputActionRowHandle, ECommonInputType InputType, const FName& GamepadName) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_CommonUISubsystem_GetInputActionButtonIcon);
+	CSV_SCOPED_TIMING_STAT(CommonUI, GetInputActionButtonIcon);
+
 	if (ensure(InputType != ECommonInputType::Count) && !InputActionRowHandle.IsNull())
 	{
 		const FCommonInputActionDataBase* InputActionData = CommonUI::GetInputActionData(InputActionRowHandle);
@@ -127,4 +153,102 @@ void UCommonUISubsystemBase::SetInputAllowed(bool bEnabled, const FName& Reason,
 		InputSubsystem->SetInputTypeFilter(ECommonInputType::Gamepad, Reason, !bEnabled);
 		InputSubsystem->SetInputTypeFilter(ECommonInputType::Touch, Reason, !bEnabled);
 	}
-}
\ No newline at end of file
+}
+
+bool UCommonUISubsystemBase::AcquireVideoResources(const UObject& Owner, FCommonVideoPlayerResources& OutResources, const FSimpleDelegate& OnResourcesAvailable)
+{
+	ReclaimOrphanedVideoResources();
+
+	if (const FCommonVideoPlayerResources* ExistingResources = VideoResourcesInUse.FindByPredicate([&Owner](const FCommonVideoPlayerResources& Resources) { return Resources.Owner == &Owner; }))
+	{
+		OutResources = *ExistingResources;
+		return true;
+	}
+
+	const int32 MaxDecoders = ICommonUIModule::GetSettings().GetMaxConcurrentVideoDecoders();
+	if (MaxDecoders > 0 && VideoResourcesInUse.Num() >= MaxDecoders)
+	{
+		CancelVideoResourcesRequest(Owner);
+		VideoResourcesRequests.Emplace(&Owner, OnResourcesAvailable);
+		return false;
+	}
+
+	FCommonVideoPlayerResources NewResources;
+	if (IdleVideoResources.Num() > 0)
+	{
+		NewResources = IdleVideoResources.Pop(false);
+		DEC_DWORD_STAT(STAT_CommonVideoPlayer_DecodersPooled);
+	}
+	else
+	{
+		NewResources = FCommonVideoPlayerResources::Create(*this);
+	}
+	NewResources.Owner = &Owner;
+
+	VideoResourcesInUse.Add(NewResources);
+	INC_DWORD_STAT(STAT_CommonVideoPlayer_DecodersInUse);
+
+	OutResources = NewResources;
+	return true;
+}
+
+void UCommonUISubsystemBase::ReleaseVideoResources(const UObject& Owner)
+{
+	const int32 ResourcesIndex = VideoResourcesInUse.IndexOfByPredicate([&Owner](const FCommonVideoPlayerResources& Resources) { return Resources.Owner == &Owner; });
+	if (ResourcesIndex != INDEX_NONE)
+	{
+		ResetVideoResources(VideoResourcesInUse[ResourcesIndex]);
+		IdleVideoResources.Add(VideoResourcesInUse[ResourcesIndex]);
+		VideoResourcesInUse.RemoveAtSwap(ResourcesIndex);
+
+		DEC_DWORD_STAT(STAT_CommonVideoPlayer_DecodersInUse);
+		INC_DWORD_STAT(STAT_CommonVideoPlayer_DecodersPooled);
+
+		ServeVideoResourcesRequests();
+	}
+}
+
+void UCommonUISubsystemBase::CancelVideoResourcesRequest(const UObject& Owner)
+{
+	VideoResourcesRequests.RemoveAll([&Owner](const TPair<TWeakObjectPtr<const UObject>, FSimpleDelegate>& Request) { return Request.Key == &Owner; });
+}
+
+void UCommonUISubsystemBase::ReclaimOrphanedVideoResources()
+{
+	for (int32 ResourcesIndex = VideoResourcesInUse.Num() - 1; ResourcesIndex >= 0; --ResourcesIndex)
+	{
+		if (!VideoResourcesInUse[ResourcesIndex].Owner.IsValid())
+		{
+			ResetVideoResources(VideoResourcesInUse[ResourcesIndex]);
+			IdleVideoResources.Add(VideoResourcesInUse[ResourcesIndex]);
+			VideoResourcesInUse.RemoveAtSwap(ResourcesIndex);
+
+			DEC_DWORD_STAT(STAT_CommonVideoPlayer_DecodersInUse);
+			INC_DWORD_STAT(STAT_CommonVideoPlayer_DecodersPooled);
+		}
+	}
+}
+
+void UCommonUISubsystemBase::ResetVideoResources(FCommonVideoPlayerResources& Resources)
+{
+	// Whoever had these last must not hear about anything the next owner does with them
+	Resources.MediaPlayer->OnMediaEvent().Clear();
+	Resources.MediaPlayer->Close();
+	Resources.MediaPlayer->SetLooping(false);
+	Resources.SoundComponent->Stop();
+	Resources.Owner.Reset();
+}
+
+void UCommonUISubsystemBase::ServeVideoResourcesRequests()
+{
+	ReclaimOrphanedVideoResources();
+
+	const int32 MaxDecoders = ICommonUIModule::GetSettings().GetMaxConcurrentVideoDecoders();
+	while (VideoResourcesRequests.Num() > 0 && (MaxDecoders <= 0 || VideoResourcesInUse.Num() < MaxDecoders))
+	{
+		// Requests are served in the order they were made, with the requester expected to acquire from within the callback
+		const FSimpleDelegate OnResourcesAvailable = VideoResourcesRequests[0].Value;
+		VideoResourcesRequests.RemoveAt(0);
+		OnResourcesAvailable.ExecuteIfBound();
+	}
+}
@@ -4,6 +4,9 @@
 #include "CommonUIPrivatePCH.h"
 #include "ICommonInputModule.h"
 #include "CommonInputSettings.h"
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CommonUI GetIconForInputActions"), STAT_CommonUI_GetIconForInputActions, STATGROUP_CommonUI);
 
 FScrollBoxStyle CommonUI::EmptyScrollBoxStyle = FScrollBoxStyle();
 
@@ -195,6 +198,9 @@ const FCommonInputActionDataBase* CommonUI::GetInputActionData(const FDataTableR
 
 FSlateBrush CommonUI::GetIconForInputActions(const UCommonInputSubsystem* CommonInputSubsystem, const TArray<FDataTableRowHandle>& InputActions)
 {
+	SCOPE_CYCLE_COUNTER(STAT_CommonUI_GetIconForInputActions);
+	CSV_SCOPED_TIMING_STAT(CommonUI, GetIconForInputActions);
+
 	TArray<FKey> Keys;
 	for (const FDataTableRowHandle& InputAction : InputActions)
 	{
@@ -9,6 +9,8 @@
 #include "Input/CommonUIActionRouterBase.h"
 #include "Input/CommonUIInputTypes.h"
 
+UCommonUserWidget::FScrollRecipientsChangedEvent UCommonUserWidget::OnScrollRecipientsChanged;
+
 UCommonUserWidget::UCommonUserWidget(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {	
@@ -113,6 +115,7 @@ void UCommonUserWidget::RegisterScrollRecipient(const UWidget& AnalogScrollRecip
 			{
 				ActionRouter->RegisterScrollRecipient(AnalogScrollRecipient);
 			}
+			OnScrollRecipientsChanged.Broadcast(*this);
 		}
 	}
 }
@@ -125,6 +128,7 @@ void UCommonUserWidget::UnregisterScrollRecipient(const UWidget& AnalogScrollRec
 		{
 			ActionRouter->UnregisterScrollRecipient(AnalogScrollRecipient);
 		}
+		OnScrollRecipientsChanged.Broadcast(*this);
 	}
 }
 
@@ -149,6 +153,11 @@ void UCommonUserWidget::OnWidgetRebuilt()
 				ActionRouter->NotifyUserWidgetConstructed(*this);
 			}
 		}
+
+		if (ScrollRecipients.Num() > 0)
+		{
+			OnScrollRecipientsChanged.Broadcast(*this);
+		}
 	}
 
 	Super::OnWidgetRebuilt();
@@ -164,6 +173,11 @@ void UCommonUserWidget::NativeDestruct()
 		}
 	}
 
+	if (ScrollRecipients.Num() > 0 && !IsDesignTime())
+	{
+		OnScrollRecipientsChanged.Broadcast(*this);
+	}
+
 	Super::NativeDestruct();
 }
 
@@ -12,86 +12,174 @@
 #include "ShaderPipelineCache.h"
 #include "IMediaEventSink.h"
 #include "Widgets/Images/SImage.h"
+#include "CommonUISubsystemBase.h"
+#include "Containers/Ticker.h"
+#include "CommonUIStats.h"
 
-UCommonVideoPlayer::UCommonVideoPlayer(const FObjectInitializer& Initializer)
-	: Super(Initializer)
-{
-	static ConstructorHelpers::FObjectFinder<UMaterial> VideoPlayerMaterialFinder(TEXT("/CommonUI/VideoPlayerMaterial"));
-	VideoMaterial = VideoPlayerMaterialFinder.Object;
-}
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CommonVideoPlayer Suspended While Not Drawn"), STAT_CommonVideoPlayer_Suspended, STATGROUP_CommonUI);
 
-void UCommonVideoPlayer::PostInitProperties()
+/** Image that remembers the last frame it was drawn in, so the video player can tell when nobody can see it */
+class SCommonVideoImage : public SImage
 {
-	Super::PostInitProperties();
-	
-	if (!IsTemplate())
+public:
+	SLATE_BEGIN_ARGS(SCommonVideoImage) {}
+		SLATE_ATTRIBUTE(const FSlateBrush*, Image)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs)
 	{
-		MediaPlayer = NewObject<UMediaPlayer>(this);
-		MediaPlayer->PlayOnOpen = false;
-		MediaPlayer->OnMediaEvent().AddUObject(this, &UCommonVideoPlayer::HandleMediaPlayerEvent);
+		SImage::Construct(SImage::FArguments().Image(InArgs._Image));
+		LastPaintFrame = GFrameCounter;
+
+		// Invalidation panels and global invalidation would otherwise reuse our cached paint without calling OnPaint,
+		// leaving the player to think it isn't being drawn while it's on screen
+		ForceVolatile(true);
+	}
+
+	/** @return How many frames have passed since the image was last painted */
+	uint64 GetFramesSincePaint() const { return GFrameCounter - LastPaintFrame; }
 
-		MediaTexture = NewObject<UMediaTexture>(this);
-		MediaTexture->AutoClear = true;
-		MediaTexture->SetMediaPlayer(MediaPlayer);
-		MediaTexture->UpdateResource();
+	/**
+	 * The number of frames between the last two paints. Usually 1, but more when something only repaints us every few frames
+	 * (ex: a retainer box with phases), in which case going that long without a paint doesn't mean we're not drawn.
+	 */
+	uint64 GetPaintInterval() const { return PaintInterval; }
 
-		if (ensure(VideoMaterial))
+protected:
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override
+	{
+		if (GFrameCounter != LastPaintFrame)
 		{
-			UMaterialInstanceDynamic* VideoMID = UMaterialInstanceDynamic::Create(VideoMaterial, this);
-			VideoMID->SetTextureParameterValue(TEXT("MediaTexture"), MediaTexture);
-			VideoBrush.SetResourceObject(VideoMID);
+			PaintInterval = GFrameCounter - LastPaintFrame;
+			LastPaintFrame = GFrameCounter;
 		}
-
-		SoundComponent = NewObject<UMediaSoundComponent>(this);
-		SoundComponent->Channels = EMediaSoundChannels::Stereo;
-		SoundComponent->bIsUISound = true;
-		
-		SoundComponent->SetMediaPlayer(MediaPlayer);
-		SoundComponent->Initialize();
-		SoundComponent->UpdatePlayer();
+		return SImage::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
 	}
+
+private:
+	mutable uint64 LastPaintFrame = 0;
+	mutable uint64 PaintInterval = 1;
+};
+
+FCommonVideoPlayerResources FCommonVideoPlayerResources::Create(UObject& Outer)
+{
+	FCommonVideoPlayerResources Resources;
+
+	Resources.MediaPlayer = NewObject<UMediaPlayer>(&Outer);
+	Resources.MediaPlayer->PlayOnOpen = false;
+
+	Resources.MediaTexture = NewObject<UMediaTexture>(&Outer);
+	Resources.MediaTexture->AutoClear = true;
+	Resources.MediaTexture->SetMediaPlayer(Resources.MediaPlayer);
+	Resources.MediaTexture->UpdateResource();
+
+	Resources.SoundComponent = NewObject<UMediaSoundComponent>(&Outer);
+	Resources.SoundComponent->Channels = EMediaSoundChannels::Stereo;
+	Resources.SoundComponent->bIsUISound = true;
+
+	Resources.SoundComponent->SetMediaPlayer(Resources.MediaPlayer);
+	Resources.SoundComponent->Initialize();
+	Resources.SoundComponent->UpdatePlayer();
+
+	return Resources;
+}
+
+UCommonVideoPlayer::UCommonVideoPlayer(const FObjectInitializer& Initializer)
+	: Super(Initializer)
+{
+	static ConstructorHelpers::FObjectFinder<UMaterial> VideoPlayerMaterialFinder(TEXT("/CommonUI/VideoPlayerMaterial"));
+	VideoMaterial = VideoPlayerMaterialFinder.Object;
+
+	// Nothing to draw until there's a media texture to draw
+	VideoBrush.DrawAs = ESlateBrushDrawType::NoDrawType;
 }
 
 void UCommonVideoPlayer::SetVideo(UMediaSource* NewVideo)
 {
-	if (MediaPlayer->GetPlaylist()->Get(0) != NewVideo)
+	Video = NewVideo;
+	if (MediaPlayer)
 	{
-		MediaPlayer->Close();
-		MediaPlayer->OpenSource(NewVideo);
+		OpenVideo();
+	}
+	else if (Video)
+	{
+		AcquireMediaResources();
 	}
 }
 
 void UCommonVideoPlayer::Seek(float PlaybackTime)
 {
-	MediaPlayer->Seek(FTimespan::FromSeconds(PlaybackTime));
+	if (MediaPlayer && MediaPlayer->IsReady())
+	{
+		MediaPlayer->Seek(FTimespan::FromSeconds(PlaybackTime));
+	}
+	else
+	{
+		PendingSeekTime = PlaybackTime;
+	}
 }
 
 void UCommonVideoPlayer::Close()
 {
-	MediaPlayer->Close();
-	SoundComponent->Stop();
+	PendingPlaybackRate = 0.f;
+	PendingSeekTime.Reset();
+	ReleaseMediaResources();
 
 	OnPlaybackComplete().Broadcast();
 }
 
 void UCommonVideoPlayer::SetPlaybackRate(float PlaybackRate)
 {
-	MediaPlayer->SetRate(PlaybackRate);
+	if (SuspendedPlaybackRate.IsSet())
+	{
+		if (PlaybackRate != 0.f)
+		{
+			// Still not being drawn, so just remember to play at the new rate once we are
+			SuspendedPlaybackRate = PlaybackRate;
+			return;
+		}
+		StopSuspensionChecks();
+	}
+
+	// Only actually playing something is worth acquiring the media resources for
+	if (PlaybackRate != 0.f)
+	{
+		AcquireMediaResources();
+	}
+
+	if (MediaPlayer && MediaPlayer->IsReady())
+	{
+		MediaPlayer->SetRate(PlaybackRate);
+		PendingPlaybackRate = 0.f;
+	}
+	else
+	{
+		PendingPlaybackRate = PlaybackRate;
+	}
 }
 
 void UCommonVideoPlayer::SetLooping(bool bShouldLoopPlayback)
 {
-	MediaPlayer->SetLooping(bShouldLoopPlayback);
+	bIsLooping = bShouldLoopPlayback;
+	if (MediaPlayer)
+	{
+		MediaPlayer->SetLooping(bShouldLoopPlayback);
+	}
 }
 
 void UCommonVideoPlayer::SetIsMuted(bool bInIsMuted)
 {
 	bIsMuted = bInIsMuted;
+	if (!SoundComponent)
+	{
+		return;
+	}
+
 	if (bIsMuted)
 	{
 		SoundComponent->Stop();
 	}
-	else if (IsPlaying())
+	else if (MediaPlayer->IsPlaying())
 	{
 		SoundComponent->Start();
 	}
@@ -109,48 +197,70 @@ void UCommonVideoPlayer::Reverse()
 
 void UCommonVideoPlayer::Pause()
 {
-	MediaPlayer->Pause();
+	StopSuspensionChecks();
+	PendingPlaybackRate = 0.f;
+	if (MediaPlayer)
+	{
+		MediaPlayer->Pause();
+	}
 }
 
 void UCommonVideoPlayer::PlayFromStart()
 {
-	MediaPlayer->Rewind();
+	if (MediaPlayer && MediaPlayer->IsReady())
+	{
+		MediaPlayer->Rewind();
+	}
+	else
+	{
+		PendingSeekTime = 0.f;
+	}
 	Play();
 }
 
 float UCommonVideoPlayer::GetVideoDuration() const
 {
-	return MediaPlayer->GetDuration().GetTotalSeconds();
+	return MediaPlayer ? MediaPlayer->GetDuration().GetTotalSeconds() : 0.f;
 }
 
 float UCommonVideoPlayer::GetPlaybackTime() const
 {
-	return MediaPlayer->GetTime().GetTotalSeconds();
+	return MediaPlayer && MediaPlayer->IsReady() ? MediaPlayer->GetTime().GetTotalSeconds() : PendingSeekTime.Get(0.f);
 }
 
 float UCommonVideoPlayer::GetPlaybackRate() const
 {
-	return MediaPlayer->GetRate();
+	if (SuspendedPlaybackRate.IsSet())
+	{
+		return SuspendedPlaybackRate.GetValue();
+	}
+	return MediaPlayer ? MediaPlayer->GetRate() : 0.f;
 }
 
 bool UCommonVideoPlayer::IsLooping() const
 {
-	return MediaPlayer->IsLooping();
+	return bIsLooping;
 }
 
 bool UCommonVideoPlayer::IsPaused() const
 {
-	return MediaPlayer->IsPaused();
+	return !SuspendedPlaybackRate.IsSet() && MediaPlayer && MediaPlayer->IsPaused();
 }
 
 bool UCommonVideoPlayer::IsPlaying() const
 {
-	return MediaPlayer->IsPlaying();
+	return SuspendedPlaybackRate.IsSet() || (MediaPlayer && MediaPlayer->IsPlaying());
 }
 
 TSharedRef<SWidget> UCommonVideoPlayer::RebuildWidget()
 {
-	return SAssignNew(MyImage, SImage)
+	// Pick back up where we were if we were playing when our slate was last released
+	if (PendingPlaybackRate != 0.f)
+	{
+		AcquireMediaResources();
+	}
+
+	return SAssignNew(MyImage, SCommonVideoImage)
 		.Image(&VideoBrush);
 }
 
@@ -158,18 +268,29 @@ void UCommonVideoPlayer::SynchronizeProperties()
 {
 	Super::SynchronizeProperties();
 	
-	SetVideo(Video);
+	// Only keep an already open video in sync, the media resources aren't acquired until something is actually played
+	if (MediaPlayer)
+	{
+		OpenVideo();
+	}
 }
 
 void UCommonVideoPlayer::ReleaseSlateResources(bool bReleaseChildren)
 {
 	Super::ReleaseSlateResources(bReleaseChildren);
 	MyImage.Reset();
+
+	if (IsPlaying())
+	{
+		PendingPlaybackRate = GetPlaybackRate();
+		PendingSeekTime = GetPlaybackTime();
+	}
+	ReleaseMediaResources();
 }
 
 void UCommonVideoPlayer::PlayInternal() const
 {
-	if (MediaPlayer->IsReady() && !MediaPlayer->IsPlaying())
+	if (MediaPlayer && MediaPlayer->IsReady() && !MediaPlayer->IsPlaying())
 	{
 		MediaPlayer->Play();
 	}
@@ -179,8 +300,12 @@ void UCommonVideoPlayer::HandleMediaPlayerEvent(EMediaEvent EventType)
 {
 	switch (EventType)
 	{
+	case EMediaEvent::MediaOpened:
+		ApplyPendingPlayback();
+		break;
 	case EMediaEvent::MediaClosed:
-		Close();
+		SoundComponent->Stop();
+		OnPlaybackComplete().Broadcast();
 		break;
 	case EMediaEvent::PlaybackEndReached:
 		if (!IsLooping())
@@ -198,6 +323,11 @@ void UCommonVideoPlayer::HandleMediaPlayerEvent(EMediaEvent EventType)
 		{
 			MyImage->RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateUObject(this, &UCommonVideoPlayer::HandlePlaybackTick));
 		}
+		if (bSuspendWhenNotDrawn && !SuspensionTickerHandle.IsValid())
+		{
+			// Slate doesn't tick what it doesn't draw, so keeping an eye on whether we're drawn has to happen outside of it
+			SuspensionTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCommonVideoPlayer::HandleSuspensionTick));
+		}
 		break;
 	case EMediaEvent::PlaybackSuspended:
 		SoundComponent->Stop();
@@ -207,7 +337,7 @@ void UCommonVideoPlayer::HandleMediaPlayerEvent(EMediaEvent EventType)
 
 void UCommonVideoPlayer::PlaybackTick(double InCurrentTime, float InDeltaTime)
 {
-	if (!bIsMuted)
+	if (!bIsMuted && SoundComponent)
 	{
 		SoundComponent->UpdatePlayer();
 	}
@@ -216,5 +346,186 @@ void UCommonVideoPlayer::PlaybackTick(double InCurrentTime, float InDeltaTime)
 EActiveTimerReturnType UCommonVideoPlayer::HandlePlaybackTick(double InCurrentTime, float InDeltaTime)
 {
 	PlaybackTick(InCurrentTime, InDeltaTime);
-	return MediaPlayer->IsPlaying() ? EActiveTimerReturnType::Continue : EActiveTimerReturnType::Stop;
-}
\ No newline at end of file
+	return MediaPlayer && MediaPlayer->IsPlaying() ? EActiveTimerReturnType::Continue : EActiveTimerReturnType::Stop;
+}
+
+bool UCommonVideoPlayer::AcquireMediaResources()
+{
+	if (MediaPlayer)
+	{
+		return true;
+	}
+	if (IsTemplate())
+	{
+		return false;
+	}
+
+	FCommonVideoPlayerResources Resources;
+	if (UCommonUISubsystemBase* UISubsystem = UCommonUISubsystemBase::Get(*this))
+	{
+		MediaResourcesPool = UISubsystem;
+		if (!UISubsystem->AcquireVideoResources(*this, Resources, FSimpleDelegate::CreateUObject(this, &UCommonVideoPlayer::HandleMediaResourcesAvailable)))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		// Outside of a game (ex: in the designer), there's no pool to draw from
+		Resources = FCommonVideoPlayerResources::Create(*this);
+	}
+
+	MediaPlayer = Resources.MediaPlayer;
+	MediaTexture = Resources.MediaTexture;
+	SoundComponent = Resources.SoundComponent;
+
+	MediaPlayer->OnMediaEvent().AddUObject(this, &UCommonVideoPlayer::HandleMediaPlayerEvent);
+	MediaPlayer->SetLooping(bIsLooping);
+
+	if (!VideoMID && ensure(VideoMaterial))
+	{
+		VideoMID = UMaterialInstanceDynamic::Create(VideoMaterial, this);
+		VideoBrush.SetResourceObject(VideoMID);
+	}
+	if (VideoMID)
+	{
+		VideoMID->SetTextureParameterValue(TEXT("MediaTexture"), MediaTexture);
+		VideoBrush.DrawAs = ESlateBrushDrawType::Image;
+	}
+
+	OpenVideo();
+	return true;
+}
+
+void UCommonVideoPlayer::ReleaseMediaResources()
+{
+	StopSuspensionChecks();
+
+	if (MediaPlayer)
+	{
+		MediaPlayer->OnMediaEvent().RemoveAll(this);
+		MediaPlayer->Close();
+		SoundComponent->Stop();
+	}
+
+	// The texture is about to be someone else's, so stop drawing it
+	if (VideoMID)
+	{
+		VideoMID->SetTextureParameterValue(TEXT("MediaTexture"), nullptr);
+		VideoBrush.DrawAs = ESlateBrushDrawType::NoDrawType;
+	}
+
+	if (UCommonUISubsystemBase* UISubsystem = MediaResourcesPool.Get())
+	{
+		if (MediaPlayer)
+		{
+			UISubsystem->ReleaseVideoResources(*this);
+		}
+		else
+		{
+			UISubsystem->CancelVideoResourcesRequest(*this);
+		}
+	}
+
+	MediaResourcesPool.Reset();
+	MediaPlayer = nullptr;
+	MediaTexture = nullptr;
+	SoundComponent = nullptr;
+}
+
+void UCommonVideoPlayer::HandleMediaResourcesAvailable()
+{
+	AcquireMediaResources();
+}
+
+void UCommonVideoPlayer::OpenVideo()
+{
+	const UMediaPlaylist* Playlist = MediaPlayer->GetPlaylist();
+	if ((Playlist ? Playlist->Get(0) : nullptr) != Video)
+	{
+		MediaPlayer->Close();
+		if (Video)
+		{
+			MediaPlayer->OpenSource(Video);
+		}
+	}
+	else if (MediaPlayer->IsReady())
+	{
+		ApplyPendingPlayback();
+	}
+}
+
+void UCommonVideoPlayer::ApplyPendingPlayback()
+{
+	if (PendingSeekTime.IsSet())
+	{
+		MediaPlayer->Seek(FTimespan::FromSeconds(PendingSeekTime.GetValue()));
+		PendingSeekTime.Reset();
+	}
+
+	if (PendingPlaybackRate != 0.f)
+	{
+		MediaPlayer->SetRate(PendingPlaybackRate);
+		PendingPlaybackRate = 0.f;
+	}
+}
+
+bool UCommonVideoPlayer::HandleSuspensionTick(float DeltaTime)
+{
+	// A paint interval beyond the cap is the gap from the last time we were hidden rather than a cadence to wait out
+	static const uint64 MaxToleratedPaintInterval = 30;
+	const bool bIsDrawn = MyImage && IsVisible()
+		&& MyImage->GetFramesSincePaint() <= (uint64)SuspendAfterUndrawnFrames + FMath::Min(MyImage->GetPaintInterval() - 1, MaxToleratedPaintInterval);
+	if (SuspendedPlaybackRate.IsSet())
+	{
+		if (bIsDrawn)
+		{
+			ResumeSuspendedPlayback();
+		}
+	}
+	else if (!MediaPlayer || !MediaPlayer->IsPlaying())
+	{
+		// Playback was stopped some other way, so there's nothing to keep an eye on until it resumes
+		SuspensionTickerHandle.Reset();
+		return false;
+	}
+	else if (!bIsDrawn)
+	{
+		SuspendPlayback();
+	}
+	return true;
+}
+
+void UCommonVideoPlayer::SuspendPlayback()
+{
+	SuspendedPlaybackRate = MediaPlayer->GetRate();
+	MediaPlayer->Pause();
+	SoundComponent->Stop();
+
+	INC_DWORD_STAT(STAT_CommonVideoPlayer_Suspended);
+}
+
+void UCommonVideoPlayer::ResumeSuspendedPlayback()
+{
+	const float PlaybackRate = SuspendedPlaybackRate.GetValue();
+	SuspendedPlaybackRate.Reset();
+	DEC_DWORD_STAT(STAT_CommonVideoPlayer_Suspended);
+
+	// Pausing holds the playback position, so playing at the same rate again carries on from exactly where we left off
+	MediaPlayer->SetRate(PlaybackRate);
+}
+
+void UCommonVideoPlayer::StopSuspensionChecks()
+{
+	if (SuspensionTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(SuspensionTickerHandle);
+		SuspensionTickerHandle.Reset();
+	}
+
+	if (SuspendedPlaybackRate.IsSet())
+	{
+		SuspendedPlaybackRate.Reset();
+		DEC_DWORD_STAT(STAT_CommonVideoPlayer_Suspended);
+	}
+}
@@ -7,18 +7,131 @@
 #include "CommonVisibilitySwitcherSlot.h"
 #include "CommonWidgetPaletteCategories.h"
 #include "Widgets/Layout/SBox.h"
+#include "Containers/Ticker.h"
+#include "Algo/Sort.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
 
 #if WITH_EDITOR
 #include "Editor/WidgetCompilerLog.h"
 #endif
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CommonVisibilitySwitcher Transition"), STAT_CommonVisibilitySwitcher_Transition, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonVisibilitySwitcher Transitions"), STAT_CommonVisibilitySwitcher_Transitions, STATGROUP_CommonUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CommonVisibilitySwitcher Unloaded Slots"), STAT_CommonVisibilitySwitcher_UnloadedSlots, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonVisibilitySwitcher Slots Reloaded"), STAT_CommonVisibilitySwitcher_SlotsReloaded, STATGROUP_CommonUI);
+
+#if !UE_BUILD_SHIPPING
+/** Counts the widgets in a Slate tree */
+static int32 CountSlateWidgets(SWidget& Widget)
+{
+	int32 NumWidgets = 1;
+	FChildren* Children = Widget.GetChildren();
+	for (int32 ChildIdx = 0; Children && ChildIdx < Children->Num(); ++ChildIdx)
+	{
+		NumWidgets += CountSlateWidgets(*Children->GetChildAt(ChildIdx));
+	}
+	return NumWidgets;
+}
+
+/**
+ * A floor on the memory held by the given number of widgets: every widget is at least an SWidget.
+ * Derived widget members and whatever the widgets own (child arrays, text layouts, brushes) come on top.
+ */
+static float EstimateMinimumSlateKB(int32 NumWidgets)
+{
+	return NumWidgets * sizeof(SWidget) / 1024.f;
+}
+
+static FAutoConsoleCommand DumpVisibilitySwitchersCommand(
+	TEXT("CommonUI.DumpVisibilitySwitchers"),
+	TEXT("Logs how many pages of each constructed visibility switcher are resident, and for each resident page how many Slate widgets it holds along with a sizeof-based lower bound on their memory."),
+	FConsoleCommandDelegate::CreateLambda([]()
+		{
+			for (TObjectIterator<UCommonVisibilitySwitcher> SwitcherIt; SwitcherIt; ++SwitcherIt)
+			{
+				UCommonVisibilitySwitcher* Switcher = *SwitcherIt;
+				if (!Switcher->GetCachedWidget().IsValid())
+				{
+					continue;
+				}
+
+				UE_LOG(LogCommonUI, Log, TEXT("%s: %d of %d slots resident"),
+					*Switcher->GetPathName(), Switcher->GetNumResidentSlots(), Switcher->GetChildrenCount());
+
+				int32 TotalWidgets = 0;
+				for (int32 ChildIdx = 0; ChildIdx < Switcher->GetChildrenCount(); ++ChildIdx)
+				{
+					const UWidget* Child = Switcher->GetChildAt(ChildIdx);
+					const UCommonVisibilitySwitcherSlot* SwitcherSlot = Child ? Cast<UCommonVisibilitySwitcherSlot>(Child->Slot) : nullptr;
+					if (SwitcherSlot && !SwitcherSlot->IsContentUnloaded() && SwitcherSlot->GetVisibilityBox().IsValid())
+					{
+						const int32 NumWidgets = CountSlateWidgets(*SwitcherSlot->GetVisibilityBox());
+						TotalWidgets += NumWidgets;
+
+						UE_LOG(LogCommonUI, Log, TEXT("    [%d] %s: %d Slate widgets, at least %.1f KB estimated from sizeof(SWidget)"), ChildIdx, *Child->GetName(), NumWidgets, EstimateMinimumSlateKB(NumWidgets));
+					}
+				}
+
+				UE_LOG(LogCommonUI, Log, TEXT("    Total: %d Slate widgets, at least %.1f KB estimated from sizeof(SWidget)"), TotalWidgets, EstimateMinimumSlateKB(TotalWidgets));
+			}
+		}));
+#endif
 
 void UCommonVisibilitySwitcher::OnWidgetRebuilt()
 {
 	Super::OnWidgetRebuilt();
 
+	// Every slot was just built, so any unload delay counts from now
+	const double CurrentTime = FPlatformTime::Seconds();
+	for (UPanelSlot* PanelSlot : Slots)
+	{
+		if (UCommonVisibilitySwitcherSlot* SwitcherSlot = Cast<UCommonVisibilitySwitcherSlot>(PanelSlot))
+		{
+			SwitcherSlot->SetLastActiveTime(CurrentTime);
+		}
+	}
+
 	ResetSlotVisibilities();
 }
 
+void UCommonVisibilitySwitcher::ReleaseSlateResources(bool bReleaseChildren)
+{
+#if STATS
+	for (const UPanelSlot* PanelSlot : Slots)
+	{
+		const UCommonVisibilitySwitcherSlot* SwitcherSlot = Cast<UCommonVisibilitySwitcherSlot>(PanelSlot);
+		if (SwitcherSlot && SwitcherSlot->IsContentUnloaded())
+		{
+			DEC_DWORD_STAT(STAT_CommonVisibilitySwitcher_UnloadedSlots);
+		}
+	}
+#endif
+
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	if (UnloadIdleSlotsTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(UnloadIdleSlotsTickerHandle);
+		UnloadIdleSlotsTickerHandle.Reset();
+	}
+}
+
+int32 UCommonVisibilitySwitcher::GetNumResidentSlots() const
+{
+	int32 NumResidentSlots = 0;
+	for (const UPanelSlot* PanelSlot : Slots)
+	{
+		const UCommonVisibilitySwitcherSlot* SwitcherSlot = Cast<UCommonVisibilitySwitcherSlot>(PanelSlot);
+		if (SwitcherSlot && SwitcherSlot->GetVisibilityBox().IsValid() && !SwitcherSlot->IsContentUnloaded())
+		{
+			++NumResidentSlots;
+		}
+	}
+	return NumResidentSlots;
+}
+
 void UCommonVisibilitySwitcher::SetActiveWidgetIndex(int32 Index)
 {
 	if (ActiveWidgetIndex == Index)
@@ -111,6 +224,10 @@ UWidget* UCommonVisibilitySwitcher::GetWidgetAtIndex(int32 Index) const
 
 void UCommonVisibilitySwitcher::SetActiveWidgetIndex_Internal(int32 Index, bool bBroadcastChange /*= true*/)
 {
+	SCOPE_CYCLE_COUNTER(STAT_CommonVisibilitySwitcher_Transition);
+	CSV_SCOPED_TIMING_STAT(CommonUI, VisibilitySwitcherTransition);
+	INC_DWORD_STAT(STAT_CommonVisibilitySwitcher_Transitions);
+
 	if (Slots.IsValidIndex(ActiveWidgetIndex))
 	{
 		if (UCommonVisibilitySwitcherSlot* OldActiveSlot = Cast<UCommonVisibilitySwitcherSlot>(Slots[ActiveWidgetIndex]))
@@ -123,6 +240,7 @@ void UCommonVisibilitySwitcher::SetActiveWidgetIndex_Internal(int32 Index, bool
 
 			UE_LOG(LogCommonUI, Verbose, TEXT("%s [%s] - Setting visibility of slot containing [%s] to Collapsed"), ANSI_TO_TCHAR(__FUNCTION__), *GetName(), *OldActiveSlot->GetName());
 			OldActiveSlot->SetSlotVisibility(ESlateVisibility::Collapsed);
+			OldActiveSlot->SetLastActiveTime(FPlatformTime::Seconds());
 		}
 	}
 
@@ -132,6 +250,14 @@ void UCommonVisibilitySwitcher::SetActiveWidgetIndex_Internal(int32 Index, bool
 	{
 		if (UCommonVisibilitySwitcherSlot* NewActiveSlot = Cast<UCommonVisibilitySwitcherSlot>(Slots[ActiveWidgetIndex]))
 		{
+			if (NewActiveSlot->IsContentUnloaded())
+			{
+				UE_LOG(LogCommonUI, Verbose, TEXT("%s [%s] - Reloading content of slot [%s]"), ANSI_TO_TCHAR(__FUNCTION__), *GetName(), *NewActiveSlot->GetName());
+				NewActiveSlot->ReloadContent();
+				DEC_DWORD_STAT(STAT_CommonVisibilitySwitcher_UnloadedSlots);
+				INC_DWORD_STAT(STAT_CommonVisibilitySwitcher_SlotsReloaded);
+			}
+
 			if (bAutoActivateSlot)
 			{
 				if (UCommonActivatableWidget* ActivatableWidget = Cast<UCommonActivatableWidget>(NewActiveSlot->Content))
@@ -146,12 +272,69 @@ void UCommonVisibilitySwitcher::SetActiveWidgetIndex_Internal(int32 Index, bool
 		}
 	}
 
+	if (UnloadIdleSlots() && !UnloadIdleSlotsTickerHandle.IsValid())
+	{
+		UnloadIdleSlotsTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCommonVisibilitySwitcher::HandleUnloadIdleSlotsTick), FMath::Min(InactiveSlotUnloadDelay, 1.f));
+	}
+
 	if (bBroadcastChange)
 	{
 		OnActiveWidgetIndexChanged().Broadcast(ActiveWidgetIndex);
 	}
 }
 
+bool UCommonVisibilitySwitcher::UnloadIdleSlots()
+{
+	if (IsDesignTime() || (InactiveSlotUnloadDelay <= 0.f && MaxResidentInactiveSlots <= 0))
+	{
+		return false;
+	}
+
+	TArray<UCommonVisibilitySwitcherSlot*, TInlineAllocator<16>> ResidentInactiveSlots;
+	for (int32 SlotIdx = 0; SlotIdx < Slots.Num(); ++SlotIdx)
+	{
+		UCommonVisibilitySwitcherSlot* SwitcherSlot = Cast<UCommonVisibilitySwitcherSlot>(Slots[SlotIdx]);
+		if (SlotIdx != ActiveWidgetIndex && SwitcherSlot && SwitcherSlot->GetVisibilityBox().IsValid() && !SwitcherSlot->IsContentUnloaded())
+		{
+			ResidentInactiveSlots.Add(SwitcherSlot);
+		}
+	}
+
+	// Most recently active first, so whatever is beyond the resident limit is least recently used
+	Algo::SortBy(ResidentInactiveSlots, &UCommonVisibilitySwitcherSlot::GetLastActiveTime, TGreater<>());
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	bool bHasSlotsAwaitingUnload = false;
+	for (int32 ResidentIdx = 0; ResidentIdx < ResidentInactiveSlots.Num(); ++ResidentIdx)
+	{
+		UCommonVisibilitySwitcherSlot* SwitcherSlot = ResidentInactiveSlots[ResidentIdx];
+		const bool bIsBeyondResidentLimit = MaxResidentInactiveSlots > 0 && ResidentIdx >= MaxResidentInactiveSlots;
+		const bool bHasBeenIdleTooLong = InactiveSlotUnloadDelay > 0.f && CurrentTime - SwitcherSlot->GetLastActiveTime() >= InactiveSlotUnloadDelay;
+		if (bIsBeyondResidentLimit || bHasBeenIdleTooLong)
+		{
+			UE_LOG(LogCommonUI, Verbose, TEXT("%s [%s] - Unloading content of slot [%s]"), ANSI_TO_TCHAR(__FUNCTION__), *GetName(), *SwitcherSlot->GetName());
+			SwitcherSlot->UnloadContent();
+			INC_DWORD_STAT(STAT_CommonVisibilitySwitcher_UnloadedSlots);
+		}
+		else if (InactiveSlotUnloadDelay > 0.f)
+		{
+			bHasSlotsAwaitingUnload = true;
+		}
+	}
+
+	return bHasSlotsAwaitingUnload;
+}
+
+bool UCommonVisibilitySwitcher::HandleUnloadIdleSlotsTick(float DeltaTime)
+{
+	if (!UnloadIdleSlots())
+	{
+		UnloadIdleSlotsTickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
 void UCommonVisibilitySwitcher::ResetSlotVisibilities()
 {
 	for (UPanelSlot* PanelSlot : Slots)
@@ -3,7 +3,257 @@
 #include "CommonWidgetCarousel.h"
 #include "CommonUIPrivatePCH.h"
 #include "CommonWidgetPaletteCategories.h"
+#include "CommonActivatableWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/WidgetSwitcher.h"
 #include "Containers/Ticker.h"
+#include "Widgets/Layout/SWidgetSwitcher.h"
+#include "CommonUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CommonWidgetCarousel AutoScroll Scheduler Tick"), STAT_CommonWidgetCarousel_AutoScrollSchedulerTick, STATGROUP_CommonUI);
+DECLARE_CYCLE_STAT(TEXT("CommonWidgetCarousel AutoScrollCallback"), STAT_CommonWidgetCarousel_AutoScrollCallback, STATGROUP_CommonUI);
+DECLARE_CYCLE_STAT(TEXT("CommonWidgetCarousel UpdateCachedPages"), STAT_CommonWidgetCarousel_UpdateCachedPages, STATGROUP_CommonUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CommonWidgetCarousel Lazily Cached Pages"), STAT_CommonWidgetCarousel_LazilyCachedPages, STATGROUP_CommonUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CommonWidgetCarousel Auto-Scrolling Active"), STAT_CommonWidgetCarousel_AutoScrollingActive, STATGROUP_CommonUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CommonWidgetCarousel Auto-Scrolling Paused"), STAT_CommonWidgetCarousel_AutoScrollingPaused, STATGROUP_CommonUI);
+
+//////////////////////////////////////////////////////////////////////////
+// FCommonCarouselAutoScrollScheduler
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * Drives the auto-scrolling of every carousel from a single ticker that only wakes when the next carousel is due to scroll.
+ * Scroll times are aligned to a shared granularity, so carousels due at about the same time are serviced by the same wakeup.
+ * Carousels nobody can see are paused rather than scrolled, and are checked again at a coarser interval until they can be seen.
+ */
+class FCommonCarouselAutoScrollScheduler
+{
+public:
+	static FCommonCarouselAutoScrollScheduler& Get()
+	{
+		static FCommonCarouselAutoScrollScheduler Instance;
+		return Instance;
+	}
+
+	void Register(UCommonWidgetCarousel& Carousel)
+	{
+		Unregister(Carousel);
+
+		Carousel.NextAutoScrollTime = AlignTime(FPlatformTime::Seconds() + Carousel.AutoScrollInterval);
+		Carousels.Add({ &Carousel, false });
+		INC_DWORD_STAT(STAT_CommonWidgetCarousel_AutoScrollingActive);
+
+		ScheduleNextWakeup();
+	}
+
+	void Unregister(UCommonWidgetCarousel& Carousel)
+	{
+		const int32 CarouselIdx = Carousels.IndexOfByPredicate([&Carousel](const FScheduledCarousel& Entry) { return Entry.Carousel == &Carousel; });
+		if (CarouselIdx != INDEX_NONE)
+		{
+			RemoveAt(CarouselIdx);
+
+			// Waking up for a carousel that's gone is harmless, so the wakeup is only cancelled once there's nothing left
+			if (Carousels.Num() == 0)
+			{
+				ScheduleNextWakeup();
+			}
+		}
+	}
+
+private:
+	struct FScheduledCarousel
+	{
+		TWeakObjectPtr<UCommonWidgetCarousel> Carousel;
+
+		/** Kept here rather than on the carousel so the stats stay balanced even if the carousel is gone by the time it's removed */
+		bool bIsPaused;
+	};
+
+	void RemoveAt(int32 CarouselIdx)
+	{
+		if (Carousels[CarouselIdx].bIsPaused)
+		{
+			DEC_DWORD_STAT(STAT_CommonWidgetCarousel_AutoScrollingPaused);
+		}
+		else
+		{
+			DEC_DWORD_STAT(STAT_CommonWidgetCarousel_AutoScrollingActive);
+		}
+		Carousels.RemoveAtSwap(CarouselIdx);
+	}
+
+	/** Seconds to which all scroll times are rounded up */
+	static constexpr double Granularity = 0.5;
+
+	/** Seconds between checks of whether paused carousels can be seen again */
+	static constexpr double PausedCheckInterval = 2.0;
+
+	static double AlignTime(double Time)
+	{
+		return FMath::CeilToDouble(Time / Granularity) * Granularity;
+	}
+
+	static bool CanAutoScroll(const UCommonWidgetCarousel& Carousel)
+	{
+		// Anything collapsed or hidden between us and the window means we can't be seen.
+		// Switchers don't hide their inactive pages, so being anywhere but the active page of a switcher counts too.
+		static const FName SwitcherType(TEXT("SWidgetSwitcher"));
+		TSharedPtr<SWidget> SlateWidget = Carousel.GetCachedWidget();
+		while (SlateWidget.IsValid())
+		{
+			if (!SlateWidget->GetVisibility().IsVisible())
+			{
+				return false;
+			}
+			if (SlateWidget->Advanced_IsWindow())
+			{
+				break;
+			}
+
+			TSharedPtr<SWidget> ParentWidget = SlateWidget->GetParentWidget();
+			if (ParentWidget && ParentWidget->GetType() == SwitcherType && StaticCastSharedPtr<SWidgetSwitcher>(ParentWidget)->GetActiveWidget() != SlateWidget)
+			{
+				return false;
+			}
+			SlateWidget = ParentWidget;
+		}
+		if (!SlateWidget.IsValid())
+		{
+			// Not in a window at all
+			return false;
+		}
+
+		// Switchers derived from SWidgetSwitcher have their own types, so the UMG hierarchy is checked for those.
+		// It's followed up through the owning user widgets, as any deactivated activatable along the way means we're not in use either.
+		const UWidget* Widget = &Carousel;
+		while (Widget)
+		{
+			const UCommonActivatableWidget* ActivatableWidget = Cast<UCommonActivatableWidget>(Widget);
+			if (ActivatableWidget && !ActivatableWidget->IsActivated())
+			{
+				return false;
+			}
+
+			if (const UPanelWidget* ParentPanel = Widget->GetParent())
+			{
+				const UWidgetSwitcher* ParentSwitcher = Cast<UWidgetSwitcher>(ParentPanel);
+				if (ParentSwitcher && ParentSwitcher->GetActiveWidget() != Widget)
+				{
+					return false;
+				}
+				Widget = ParentPanel;
+			}
+			else
+			{
+				const UWidgetTree* WidgetTree = Cast<UWidgetTree>(Widget->GetOuter());
+				Widget = WidgetTree ? Cast<UUserWidget>(WidgetTree->GetOuter()) : nullptr;
+			}
+		}
+		return true;
+	}
+
+	/** Replaces any pending wakeup with one at the earliest scroll time of the active carousels, or the next check of the paused ones */
+	void ScheduleNextWakeup()
+	{
+		if (TickerHandle.IsValid())
+		{
+			FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+			TickerHandle.Reset();
+		}
+
+		double WakeupTime = MAX_dbl;
+		for (const FScheduledCarousel& Entry : Carousels)
+		{
+			if (Entry.bIsPaused)
+			{
+				WakeupTime = FMath::Min(WakeupTime, NextPausedCheckTime);
+			}
+			else if (const UCommonWidgetCarousel* Carousel = Entry.Carousel.Get())
+			{
+				WakeupTime = FMath::Min(WakeupTime, Carousel->NextAutoScrollTime);
+			}
+		}
+
+		if (WakeupTime != MAX_dbl)
+		{
+			const float Delay = FMath::Max(0.f, (float)(WakeupTime - FPlatformTime::Seconds()));
+			TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCommonCarouselAutoScrollScheduler::Tick), Delay);
+		}
+	}
+
+	bool Tick(float DeltaTime)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_CommonWidgetCarousel_AutoScrollSchedulerTick);
+
+		// Every wakeup is a one-off, scheduled again below once we know when the next carousel is due
+		TickerHandle.Reset();
+
+		const double CurrentTime = FPlatformTime::Seconds();
+		const bool bCheckPausedCarousels = CurrentTime >= NextPausedCheckTime;
+		bool bHasPausedCarousels = false;
+		for (int32 CarouselIdx = Carousels.Num() - 1; CarouselIdx >= 0; --CarouselIdx)
+		{
+			FScheduledCarousel& Entry = Carousels[CarouselIdx];
+			UCommonWidgetCarousel* Carousel = Entry.Carousel.Get();
+			if (!Carousel)
+			{
+				// Carousels unregister as they're released, so this is only a safety net
+				RemoveAt(CarouselIdx);
+				continue;
+			}
+
+			// Whether an active carousel can be seen only matters once it's due to scroll
+			const bool bIsDue = Entry.bIsPaused ? bCheckPausedCarousels : CurrentTime >= Carousel->NextAutoScrollTime;
+			if (!bIsDue)
+			{
+				bHasPausedCarousels |= Entry.bIsPaused;
+				continue;
+			}
+
+			const bool bShouldPause = !CanAutoScroll(*Carousel);
+			bHasPausedCarousels |= bShouldPause;
+			if (bShouldPause != Entry.bIsPaused)
+			{
+				Entry.bIsPaused = bShouldPause;
+				if (bShouldPause)
+				{
+					DEC_DWORD_STAT(STAT_CommonWidgetCarousel_AutoScrollingActive);
+					INC_DWORD_STAT(STAT_CommonWidgetCarousel_AutoScrollingPaused);
+				}
+				else
+				{
+					// Give whoever can now see the carousel the full interval on the current page
+					Carousel->NextAutoScrollTime = AlignTime(CurrentTime + Carousel->AutoScrollInterval);
+					DEC_DWORD_STAT(STAT_CommonWidgetCarousel_AutoScrollingPaused);
+					INC_DWORD_STAT(STAT_CommonWidgetCarousel_AutoScrollingActive);
+				}
+			}
+
+			if (!bShouldPause && CurrentTime >= Carousel->NextAutoScrollTime)
+			{
+				Carousel->NextAutoScrollTime = AlignTime(CurrentTime + Carousel->AutoScrollInterval);
+				Carousel->AutoScrollCallback(DeltaTime);
+			}
+		}
+
+		if (bHasPausedCarousels && NextPausedCheckTime <= CurrentTime)
+		{
+			NextPausedCheckTime = CurrentTime + PausedCheckInterval;
+		}
+
+		ScheduleNextWakeup();
+		return false;
+	}
+
+	TArray<FScheduledCarousel> Carousels;
+	FDelegateHandle TickerHandle;
+	double NextPausedCheckTime = 0.;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// UCommonWidgetCarousel
+//////////////////////////////////////////////////////////////////////////
 
 UCommonWidgetCarousel::UCommonWidgetCarousel(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -18,6 +268,8 @@ void UCommonWidgetCarousel::ReleaseSlateResources(bool bReleaseChildren)
 
 	MyCommonWidgetCarousel.Reset();
 	CachedSlotWidgets.Empty();
+	DEC_DWORD_STAT_BY(STAT_CommonWidgetCarousel_LazilyCachedPages, LazySlotWidgets.Num());
+	LazySlotWidgets.Empty();
 
 	EndAutoScrolling();
 }
@@ -25,21 +277,18 @@ void UCommonWidgetCarousel::ReleaseSlateResources(bool bReleaseChildren)
 void UCommonWidgetCarousel::BeginAutoScrolling(float ScrollInterval)
 {
 	EndAutoScrolling();
-	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCommonWidgetCarousel::AutoScrollCallback), ScrollInterval);
+	AutoScrollInterval = ScrollInterval;
+	FCommonCarouselAutoScrollScheduler::Get().Register(*this);
 }
 
 void UCommonWidgetCarousel::EndAutoScrolling()
 {
-	if ( TickerHandle.IsValid() )
-	{
-		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
-		TickerHandle.Reset();
-	}
+	FCommonCarouselAutoScrollScheduler::Get().Unregister(*this);
 }
 
 bool UCommonWidgetCarousel::AutoScrollCallback(float DeltaTime)
 {
-    QUICK_SCOPE_CYCLE_COUNTER(STAT_UCommonWidgetCarousel_AutoScrollCallback);
+    SCOPE_CYCLE_COUNTER(STAT_CommonWidgetCarousel_AutoScrollCallback);
 
 	if ( MyCommonWidgetCarousel.IsValid() )
 	{
@@ -120,6 +369,27 @@ void UCommonWidgetCarousel::OnSlotAdded(UPanelSlot* InSlot)
 	}
 }
 
+void UCommonWidgetCarousel::OnSlotRemoved(UPanelSlot* InSlot)
+{
+	// The slot's content is still set at this point, so its widget can be let go of before the slot is released
+	if (LazySlotWidgets.Remove(InSlot) > 0)
+	{
+		DEC_DWORD_STAT(STAT_CommonWidgetCarousel_LazilyCachedPages);
+	}
+	if (InSlot->Content)
+	{
+		if (TSharedPtr<SWidget> ContentWidget = InSlot->Content->GetCachedWidget())
+		{
+			CachedSlotWidgets.Remove(ContentWidget.ToSharedRef());
+		}
+	}
+
+	if (MyCommonWidgetCarousel)
+	{
+		MyCommonWidgetCarousel->GenerateCurrentWidgets();
+	}
+}
+
 TSharedRef<SWidget> UCommonWidgetCarousel::RebuildWidget()
 {
 	MyCommonWidgetCarousel = SNew(SWidgetCarousel<UPanelSlot*>)
@@ -131,15 +401,21 @@ TSharedRef<SWidget> UCommonWidgetCarousel::RebuildWidget()
 		.OnGenerateWidget_UObject(this, &UCommonWidgetCarousel::OnGenerateWidgetForCarousel)
 		.OnPageChanged_UObject(this, &UCommonWidgetCarousel::HandlePageChanged);
 
+	const bool bGenerateLazily = bGeneratePagesLazily && !IsDesignTime();
 	for (UPanelSlot* PanelSlot : Slots)
 	{
 		PanelSlot->Parent = this;
-		if (PanelSlot->Content)
+		if (PanelSlot->Content && !bGenerateLazily)
 		{
 			CachedSlotWidgets.AddUnique(PanelSlot->Content->TakeWidget());
 		}
 	}
 
+	if (bGenerateLazily)
+	{
+		UpdateCachedPages(FMath::Clamp(ActiveWidgetIndex, 0, FMath::Max(0, Slots.Num() - 1)));
+	}
+
 	return MyCommonWidgetCarousel.ToSharedRef();
 }
 
@@ -147,6 +423,16 @@ TSharedRef<SWidget> UCommonWidgetCarousel::OnGenerateWidgetForCarousel(UPanelSlo
 {
 	if ( UWidget* Content = PanelSlot->Content )
 	{
+		if (bGeneratePagesLazily && !IsDesignTime())
+		{
+			if (const TSharedRef<SWidget>* LazySlotWidget = LazySlotWidgets.Find(PanelSlot))
+			{
+				return *LazySlotWidget;
+			}
+
+			INC_DWORD_STAT(STAT_CommonWidgetCarousel_LazilyCachedPages);
+			return LazySlotWidgets.Add(PanelSlot, Content->TakeWidget());
+		}
 		return Content->TakeWidget();
 	}
 
@@ -155,12 +441,47 @@ TSharedRef<SWidget> UCommonWidgetCarousel::OnGenerateWidgetForCarousel(UPanelSlo
 
 void UCommonWidgetCarousel::HandlePageChanged(int32 PageIndex)
 {
+	if (bGeneratePagesLazily && !IsDesignTime())
+	{
+		UpdateCachedPages(PageIndex);
+	}
+
 	if (!IsDesignTime())
 	{
 		OnCurrentPageIndexChanged.Broadcast(this, PageIndex);
 	}
 }
 
+void UCommonWidgetCarousel::UpdateCachedPages(int32 PageIndex)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CommonWidgetCarousel_UpdateCachedPages);
+
+	for (int32 SlotIdx = 0; SlotIdx < Slots.Num(); ++SlotIdx)
+	{
+		UPanelSlot* PanelSlot = Slots[SlotIdx];
+		if (IsWithinCachedPages(SlotIdx, PageIndex))
+		{
+			// Prefetch the neighbours so they're ready to slide in
+			OnGenerateWidgetForCarousel(PanelSlot);
+		}
+		else if (LazySlotWidgets.Remove(PanelSlot) > 0)
+		{
+			DEC_DWORD_STAT(STAT_CommonWidgetCarousel_LazilyCachedPages);
+			if (PanelSlot->Content)
+			{
+				PanelSlot->Content->ReleaseSlateResources(true);
+			}
+		}
+	}
+}
+
+bool UCommonWidgetCarousel::IsWithinCachedPages(int32 SlotIndex, int32 PageIndex) const
+{
+	// The carousel wraps around, so the distance between pages does too
+	const int32 Distance = FMath::Abs(SlotIndex - PageIndex);
+	return FMath::Min(Distance, Slots.Num() - Distance) <= FMath::Max(NumCachedNeighbourPages, 1);
+}
+
 void UCommonWidgetCarousel::SynchronizeProperties()
 {
 	Super::SynchronizeProperties();
@@ -5,6 +5,10 @@
 #include "Slate/SObjectWidget.h"
 #include "Blueprint/UserWidget.h"
 #include "Input/CommonUIActionRouterBase.h"
+#include "CommonActivatableWidget.h"
+#include "CommonButtonBase.h"
+#include "Input/CommonInteractableSpatialHash.h"
+#include "HAL/IConsoleManager.h"
 #include "CommonInputSubsystem.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Engine/LocalPlayer.h"
@@ -21,9 +25,12 @@
 #include "Components/ScrollBox.h"
 #include "Engine/Engine.h"
 #include "Slate/SGameLayerManager.h"
+#include "CommonUIStats.h"
 
 #define LOCTEXT_NAMESPACE "CommonAnalogCursor"
 
+DECLARE_CYCLE_STAT(TEXT("CommonAnalogCursor Tick"), STAT_CommonAnalogCursor_Tick, STATGROUP_CommonUI);
+
 
 //@todo DanH: CVar for forcing analog movement to be enabled
 
@@ -31,6 +38,30 @@
 const float AnalogScrollUpdatePeriod = 0.1f;
 const float ScrollDeadZone = 0.2f;
 
+bool GCommonAnalogCursorUseSpatialHash = false;
+static FAutoConsoleVariableRef CVarCommonAnalogCursorUseSpatialHash(
+	TEXT("CommonUI.AnalogCursor.UseSpatialHash"),
+	GCommonAnalogCursorUseSpatialHash,
+	TEXT("If true, analog cursor movement finds painted buttons via a spatial hash of their rects, and only hit-tests under the cursor when the hash has no painted button there"),
+	ECVF_Default
+);
+
+float GCommonAnalogCursorMagnetismRadius = 0.f;
+static FAutoConsoleVariableRef CVarCommonAnalogCursorMagnetismRadius(
+	TEXT("CommonUI.AnalogCursor.MagnetismRadius"),
+	GCommonAnalogCursorMagnetismRadius,
+	TEXT("With the spatial hash in use, the distance (in slate units) within which a resting cursor is pulled onto the nearest interactable. 0 disables magnetism."),
+	ECVF_Default
+);
+
+float GCommonAnalogCursorMagnetismSpeed = 8.f;
+static FAutoConsoleVariableRef CVarCommonAnalogCursorMagnetismSpeed(
+	TEXT("CommonUI.AnalogCursor.MagnetismSpeed"),
+	GCommonAnalogCursorMagnetismSpeed,
+	TEXT("Interpolation speed at which a resting cursor is pulled onto the nearest interactable"),
+	ECVF_Default
+);
+
 FString ToDebugString(const TSharedPtr<SWidget>& Widget)
 {
 	if (Widget)
@@ -58,6 +89,10 @@ FCommonAnalogCursor::FCommonAnalogCursor(const UCommonUIActionRouterBase& InActi
 	, ActiveInputMethod(ECommonInputType::MouseAndKeyboard)
 {}
 
+FCommonAnalogCursor::~FCommonAnalogCursor()
+{
+}
+
 void FCommonAnalogCursor::Initialize()
 {
 	RefreshCursorSettings();
@@ -69,6 +104,12 @@ void FCommonAnalogCursor::Initialize()
 	UCommonInputSubsystem& InputSubsystem = ActionRouter.GetInputSubsystem();
 	InputSubsystem.OnInputMethodChangedNative.AddSP(this, &FCommonAnalogCursor::HandleInputMethodChanged);
 	HandleInputMethodChanged(InputSubsystem.GetCurrentInputType());
+
+	UCommonUserWidget::OnScrollRecipientsChanged.AddSP(this, &FCommonAnalogCursor::HandleScrollRecipientsChanged);
+	UCommonActivatableWidget::OnActivationChanged.AddSP(this, &FCommonAnalogCursor::HandleActivationChanged);
+	UCommonButtonBase::OnButtonConstructed.AddSP(this, &FCommonAnalogCursor::HandleButtonConstructed);
+	UCommonButtonBase::OnButtonDestructed.AddSP(this, &FCommonAnalogCursor::HandleButtonDestructed);
+	UCommonButtonBase::OnButtonPaintedRectChanged.AddSP(this, &FCommonAnalogCursor::HandleButtonPaintedRectChanged);
 }
 
 #if WITH_EDITOR
@@ -77,15 +118,33 @@ extern bool IsViewportWindowInFocusPath(const UCommonUIActionRouterBase& Router)
 
 void FCommonAnalogCursor::Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor)
 {
+	SCOPE_CYCLE_COUNTER(STAT_CommonAnalogCursor_Tick);
+	CSV_SCOPED_TIMING_STAT(CommonUI, AnalogCursorTick);
+
+	const TSharedPtr<FSlateUser> SlateUser = SlateApp.GetUser(GetOwnerUserIndex());
+	if (!SlateUser)
+	{
+		return;
+	}
+
+	TSharedPtr<SWidget> FocusedWidget = SlateUser->GetFocusedWidget();
+	if (!LastFocusedWidget.HasSameObject(FocusedWidget.Get()))
+	{
+		LastFocusedWidget = FocusedWidget;
+		bIsCursorTargetDirty = true;
+		bIsCursorVisibilityDirty = true;
+	}
+
 	//@todo DanH: Cursor visibility was getting thrown off somehow on PS4 and P2 wound up permanently showing the cursor
-	//		Will circle back on this, but for now refreshing a single bool each frame is relatively harmless.
-	RefreshCursorVisibility();
+	//		So beyond changes to the desired visibility, it's also refreshed whenever focus or the input method changes.
+	if (bIsCursorVisibilityDirty || ShouldShowCursor() != bIsCursorShown)
+	{
+		RefreshCursorVisibility();
+	}
 
 	// Don't bother trying to do anything while the game viewport has capture
 	if (IsUsingGamepad() && IsGameViewportInFocusPathWithoutCapture())
 	{
-		// The game viewport can't have been focused without a user, so we're quite safe to assume/enforce validity of the user here
-		const TSharedRef<FSlateUser> SlateUser = SlateApp.GetUser(GetOwnerUserIndex()).ToSharedRef();
 
 #if WITH_EDITOR
 		// Instantly acknowledge any changes to our settings when we're in the editor
@@ -97,25 +156,51 @@ void FCommonAnalogCursor::Tick(const float DeltaTime, FSlateApplication& SlateAp
 #endif
 		if (bIsAnalogMovementEnabled)
 		{
-			FAnalogCursor::Tick(DeltaTime, SlateApp, Cursor);
+			if (GCommonAnalogCursorUseSpatialHash)
+			{
+				TickAnalogMovement(DeltaTime, SlateApp, SlateUser.ToSharedRef());
+			}
+			else
+			{
+				InteractableHash.Reset();
+				FAnalogCursor::Tick(DeltaTime, SlateApp, Cursor);
+			}
 		}
 		else
 		{
 			TSharedPtr<SWidget> PinnedLastCursorTarget = LastCursorTarget.Pin();
 
 			// By default the cursor target is the focused widget itself, unless we're working with a list view
-			TSharedPtr<SWidget> CursorTarget = SlateUser->GetFocusedWidget();
+			TSharedPtr<SWidget> CursorTarget = FocusedWidget;
 			if (TSharedPtr<ITableViewMetadata> TableViewMetadata = CursorTarget ? CursorTarget->GetMetaData<ITableViewMetadata>() : nullptr)
 			{
 				//@todo DanH: When a list is focused but the selected row isn't visible, should we try to hide the cursor or anything?
-				// A list view is currently focused, so we actually want to make sure we are centering the cursor over the currently selected row instead
-				TArray<TSharedPtr<ITableRow>> SelectedRows = TableViewMetadata->GatherSelectedRows();
-				if (SelectedRows.Num() > 0 && ensure(SelectedRows[0].IsValid()))
+				// A list view is currently focused, so we actually want to make sure we are centering the cursor over the currently selected row instead.
+				// Gathering the selected rows allocates, so it's only done when input or focus could have changed the selection, or the row we found last time has moved, gone away or is no longer selected.
+				// The last check catches selection changed from code (or by the items being refreshed), which doesn't involve any input at all.
+				TSharedPtr<ITableRow> SelectedRow = LastSelectedRow.Pin();
+				TSharedPtr<SWidget> SelectedRowWidget = SelectedRow ? SelectedRow->AsWidget() : TSharedPtr<SWidget>();
+				if (bIsCursorTargetDirty || !SelectedRow || !SelectedRow->IsItemSelected() || SelectedRowWidget->GetCachedGeometry().GetAccumulatedRenderTransform() != LastCursorTargetTransform)
 				{
-					// Just pick the first selected entry in the list - it's awfully rare to have anything other than single-selection when using gamepad
-					CursorTarget = SelectedRows[0]->AsWidget();
+					SelectedRow.Reset();
+					SelectedRowWidget.Reset();
+
+					TArray<TSharedPtr<ITableRow>> SelectedRows = TableViewMetadata->GatherSelectedRows();
+					if (SelectedRows.Num() > 0 && ensure(SelectedRows[0].IsValid()))
+					{
+						// Just pick the first selected entry in the list - it's awfully rare to have anything other than single-selection when using gamepad
+						SelectedRow = SelectedRows[0];
+						SelectedRowWidget = SelectedRow->AsWidget();
+					}
+					LastSelectedRow = SelectedRow;
+				}
+
+				if (SelectedRowWidget)
+				{
+					CursorTarget = SelectedRowWidget;
 				}
 			}
+			bIsCursorTargetDirty = false;
 
 			// We want to update the cursor position when focus changes or the focused widget moves at all
 			if (CursorTarget != PinnedLastCursorTarget || (CursorTarget && CursorTarget->GetCachedGeometry().GetAccumulatedRenderTransform() != LastCursorTargetTransform))
@@ -149,7 +234,8 @@ void FCommonAnalogCursor::Tick(const float DeltaTime, FSlateApplication& SlateAp
 						TargetGeometry = CursorTarget->GetCachedGeometry();
 					}
 					
-					LastCursorTargetTransform = TargetGeometry.GetAccumulatedRenderTransform();
+					// Compare against the target's own transform from here on, even when centering within the player's host layer
+					LastCursorTargetTransform = CursorTarget->GetCachedGeometry().GetAccumulatedRenderTransform();
 					if (TargetGeometry.GetLocalSize().SizeSquared() > SMALL_NUMBER)
 					{
 						bHasValidCursorTarget = true;
@@ -172,8 +258,12 @@ void FCommonAnalogCursor::Tick(const float DeltaTime, FSlateApplication& SlateAp
 			if (TimeUntilScrollUpdate <= 0.0f && GetAnalogValues(EAnalogStick::Right).SizeSquared() > FMath::Square(ScrollDeadZone))
 			{
 				// Generate mouse wheel events over all widgets currently registered as scroll recipients
-				const TArray<const UWidget*>& AnalogScrollRecipients = ActionRouter.GatherActiveAnalogScrollRecipients();
-				if (AnalogScrollRecipients.Num() > 0)
+				if (bScrollRecipientsDirty)
+				{
+					RefreshScrollRecipients();
+				}
+
+				if (ScrollRecipients.Num() > 0)
 				{
 					const FCommonAnalogCursorSettings& CursorSettings = UCommonUIInputSettings::Get().GetAnalogCursorSettings();
 					const auto GetScrollAmountFunc = [&CursorSettings](float AnalogValue)
@@ -189,16 +279,15 @@ void FCommonAnalogCursor::Tick(const float DeltaTime, FSlateApplication& SlateAp
 					const FVector2D& RightStickValues = GetAnalogValues(EAnalogStick::Right);
 					const FVector2D ScrollAmounts(GetScrollAmountFunc(RightStickValues.X), GetScrollAmountFunc(RightStickValues.Y));
 
-					for (const UWidget* ScrollRecipient : AnalogScrollRecipients)
+					for (const FAnalogScrollRecipient& ScrollRecipient : ScrollRecipients)
 					{
-						check(ScrollRecipient);
-						if (ScrollRecipient->GetCachedWidget())
+						const UWidget* RecipientWidget = ScrollRecipient.Widget.Get();
+						if (RecipientWidget && RecipientWidget->GetCachedWidget())
 						{
-							const EOrientation Orientation = DetermineScrollOrientation(*ScrollRecipient);
-							const float ScrollAmount = Orientation == Orient_Vertical ? ScrollAmounts.Y : ScrollAmounts.X;
+							const float ScrollAmount = ScrollRecipient.bIsVertical ? ScrollAmounts.Y : ScrollAmounts.X;
 							if (FMath::Abs(ScrollAmount) > SMALL_NUMBER)
 							{
-								const FVector2D WidgetCenter = ScrollRecipient->GetCachedGeometry().GetAbsolutePositionAtCoordinates(FVector2D(.5f, .5f));
+								const FVector2D WidgetCenter = RecipientWidget->GetCachedGeometry().GetAbsolutePositionAtCoordinates(FVector2D(.5f, .5f));
 								if (IsInViewport(WidgetCenter))
 								{
 									FPointerEvent MouseEvent(
@@ -226,6 +315,9 @@ bool FCommonAnalogCursor::HandleKeyDownEvent(FSlateApplication& SlateApp, const
 {
 	if (IsRelevantInput(InKeyEvent))
 	{
+		// Navigation may well change the selection within a focused list
+		bIsCursorTargetDirty = true;
+
 		const ULocalPlayer& LocalPlayer = *ActionRouter.GetLocalPlayerChecked();
 		if (LocalPlayer.ViewportClient && LocalPlayer.ViewportClient->ViewportConsole && LocalPlayer.ViewportClient->ViewportConsole->ConsoleActive())
 		{
@@ -244,7 +336,7 @@ bool FCommonAnalogCursor::HandleKeyDownEvent(FSlateApplication& SlateApp, const
 		{
 			ShoulderButtonStatus = EShoulderButtonFlags::None;
 			bIsAnalogMovementEnabled = !bIsAnalogMovementEnabled;
-			//RefreshCursorVisibility();
+			bIsCursorVisibilityDirty = true;
 		}
 #endif
 
@@ -307,6 +399,8 @@ bool FCommonAnalogCursor::HandleAnalogInputEvent(FSlateApplication& SlateApp, co
 {
 	if (IsRelevantInput(InAnalogInputEvent))
 	{
+		bIsCursorTargetDirty = true;
+
 		bool bParentHandled = FAnalogCursor::HandleAnalogInputEvent(SlateApp, InAnalogInputEvent);
 		if (bIsAnalogMovementEnabled)
 		{
@@ -476,8 +570,175 @@ void FCommonAnalogCursor::HandleInputMethodChanged(ECommonInputType NewInputMeth
 	if (IsUsingGamepad())
 	{
 		LastCursorTarget.Reset();
+		bIsCursorTargetDirty = true;
+	}
+	bIsCursorVisibilityDirty = true;
+}
+
+void FCommonAnalogCursor::HandleScrollRecipientsChanged(UCommonUserWidget& Widget)
+{
+	const ULocalPlayer* OwningLocalPlayer = Widget.GetOwningLocalPlayer();
+	if (!OwningLocalPlayer || OwningLocalPlayer == ActionRouter.GetLocalPlayerChecked())
+	{
+		bScrollRecipientsDirty = true;
+	}
+}
+
+void FCommonAnalogCursor::HandleActivationChanged(UCommonActivatableWidget& Widget)
+{
+	// Activation changes which recipients are active, so it's treated just like a registration change
+	HandleScrollRecipientsChanged(Widget);
+}
+
+void FCommonAnalogCursor::RefreshScrollRecipients()
+{
+	bScrollRecipientsDirty = false;
+
+	ScrollRecipients.Reset();
+	for (const UWidget* ScrollRecipient : ActionRouter.GatherActiveAnalogScrollRecipients())
+	{
+		check(ScrollRecipient);
+		FAnalogScrollRecipient& NewRecipient = ScrollRecipients.AddDefaulted_GetRef();
+		NewRecipient.Widget = ScrollRecipient;
+		NewRecipient.bIsVertical = DetermineScrollOrientation(*ScrollRecipient) == Orient_Vertical;
+	}
+}
+
+void FCommonAnalogCursor::TickAnalogMovement(const float DeltaTime, FSlateApplication& SlateApp, const TSharedRef<FSlateUser>& SlateUser)
+{
+	EnsureInteractableHash();
+
+	// Keep our sub-pixel position unless something else has moved the cursor
+	const FVector2D CursorPosition = SlateUser->GetCursorPosition();
+	if (!PreciseCursorPosition.Equals(CursorPosition, 1.f))
+	{
+		PreciseCursorPosition = CursorPosition;
+	}
+	FVector2D NewPosition = PreciseCursorPosition;
+
+	const FVector2D& AnalogValues = GetAnalogValues();
+	const float AnalogMagnitude = AnalogValues.Size();
+	if (AnalogMagnitude > DeadZone)
+	{
+		// Friction - slow down while over anything interactable
+		// The hash only vouches for buttons it has seen painted, so anything else under the cursor is found by the regular hit test
+		bool bIsOverInteractable = false;
+		if (const UCommonButtonBase* ButtonUnderCursor = FindPaintedButton(InteractableHash->FindWidgetAt(PreciseCursorPosition)))
+		{
+			const TSharedPtr<SWidget> SlateWidget = ButtonUnderCursor->GetCachedWidget();
+			bIsOverInteractable = SlateWidget && SlateWidget->IsInteractable();
+		}
+		else
+		{
+			bIsOverInteractable = IsInteractableUnderCursor(SlateApp, *SlateUser);
+		}
+		const float SpeedMultiplier = bIsOverInteractable ? StickySlowdown : 1.f;
+
+		const float Intensity = FMath::Clamp((AnalogMagnitude - DeadZone) / (1.f - DeadZone), 0.f, 1.f);
+		const float TargetSpeed = MaxSpeed * Intensity;
+		AnalogCursorSpeed = Mode == AnalogCursorMode::Accelerated ? FMath::Min(AnalogCursorSpeed + Acceleration * DeltaTime, TargetSpeed) : TargetSpeed;
+
+		NewPosition += (AnalogValues / AnalogMagnitude) * AnalogCursorSpeed * SpeedMultiplier * DeltaTime;
+	}
+	else
+	{
+		AnalogCursorSpeed = 0.f;
+
+		// Magnetism - once the stick is released, pull the cursor onto the nearest interactable
+		if (GCommonAnalogCursorMagnetismRadius > 0.f)
+		{
+			if (const UCommonButtonBase* NearestButton = FindPaintedButton(InteractableHash->FindNearestWidget(PreciseCursorPosition, GCommonAnalogCursorMagnetismRadius)))
+			{
+				const FVector2D ButtonCenter = NearestButton->GetLastPaintedRect().GetCenter();
+				NewPosition = FMath::Vector2DInterpTo(PreciseCursorPosition, ButtonCenter, DeltaTime, GCommonAnalogCursorMagnetismSpeed);
+			}
+		}
+	}
+
+	if (NewPosition != PreciseCursorPosition)
+	{
+		PreciseCursorPosition = ClampPositionToViewport(NewPosition);
+		UpdateCursorPosition(SlateApp, SlateUser, PreciseCursorPosition);
+	}
+}
+
+void FCommonAnalogCursor::EnsureInteractableHash()
+{
+	if (InteractableHash)
+	{
+		return;
+	}
+
+	// Seeded once from the buttons painted last frame, after which buttons update their own entries as they're painted
+	InteractableHash = MakeUnique<FCommonInteractableSpatialHash>();
+	for (auto InteractableIt = TrackedInteractables.CreateIterator(); InteractableIt; ++InteractableIt)
+	{
+		const UCommonButtonBase* Button = InteractableIt->Get();
+		if (!Button)
+		{
+			InteractableIt.RemoveCurrent();
+		}
+		else if (GFrameCounter <= Button->GetLastPaintFrame() + 1)
+		{
+			InteractableHash->UpdateWidget(*Button, Button->GetLastPaintedRect());
+		}
+	}
+}
+
+const UCommonButtonBase* FCommonAnalogCursor::FindPaintedButton(const UWidget* FoundWidget)
+{
+	const UCommonButtonBase* Button = Cast<const UCommonButtonBase>(FoundWidget);
+	if (!Button)
+	{
+		return nullptr;
+	}
+
+	if (!Button->GetCachedWidget())
+	{
+		InteractableHash->RemoveWidget(*Button);
+		return nullptr;
+	}
+
+	// A button that wasn't painted last frame may be hidden or off screen, but it may just as well be showing the cached paint of
+	// an invalidation panel - its entry is kept for when it's next painted, and the caller falls back to the hit test meanwhile
+	return GFrameCounter <= Button->GetLastPaintFrame() + 1 ? Button : nullptr;
+}
+
+bool FCommonAnalogCursor::IsInteractableUnderCursor(FSlateApplication& SlateApp, const FSlateUser& SlateUser) const
+{
+	const FWidgetPath WidgetsUnderCursor = SlateApp.LocateWindowUnderMouse(PreciseCursorPosition, SlateApp.GetInteractiveTopLevelWindows(), false, SlateUser.GetUserIndex());
+	for (int32 WidgetIdx = WidgetsUnderCursor.Widgets.Num() - 1; WidgetIdx >= 0; --WidgetIdx)
+	{
+		if (WidgetsUnderCursor.Widgets[WidgetIdx].Widget->IsInteractable())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FCommonAnalogCursor::HandleButtonConstructed(UCommonButtonBase& Button)
+{
+	if (Button.GetOwningLocalPlayer() == ActionRouter.GetLocalPlayerChecked())
+	{
+		TrackedInteractables.Add(&Button);
+	}
+}
+
+void FCommonAnalogCursor::HandleButtonDestructed(UCommonButtonBase& Button)
+{
+	if (TrackedInteractables.Remove(&Button) > 0 && InteractableHash)
+	{
+		InteractableHash->RemoveWidget(Button);
+	}
+}
+
+void FCommonAnalogCursor::HandleButtonPaintedRectChanged(const UCommonButtonBase& Button)
+{
+	if (InteractableHash && TrackedInteractables.Contains(&Button))
+	{
+		InteractableHash->UpdateWidget(Button, Button.GetLastPaintedRect());
 	}
-	//RefreshCursorVisibility();
 }
 
 void FCommonAnalogCursor::RefreshCursorSettings()
@@ -495,16 +756,24 @@ void FCommonAnalogCursor::RefreshCursorVisibility()
 	FSlateApplication& SlateApp = FSlateApplication::Get();
 	if (TSharedPtr<FSlateUser> SlateUser = SlateApp.GetUser(GetOwnerUserIndex()))
 	{
-		const bool bShowCursor = bIsAnalogMovementEnabled || ActionRouter.ShouldAlwaysShowCursor() || ActiveInputMethod == ECommonInputType::MouseAndKeyboard;
+		const bool bShowCursor = ShouldShowCursor();
 
 		if (!bShowCursor)
 		{
 			SlateApp.SetPlatformCursorVisibility(false);
 		}
 		SlateUser->SetCursorVisibility(bShowCursor);
+
+		bIsCursorShown = bShowCursor;
+		bIsCursorVisibilityDirty = false;
 	}
 }
 
+bool FCommonAnalogCursor::ShouldShowCursor() const
+{
+	return bIsAnalogMovementEnabled || ActionRouter.ShouldAlwaysShowCursor() || ActiveInputMethod == ECommonInputType::MouseAndKeyboard;
+}
+
 bool FCommonAnalogCursor::IsUsingGamepad() const
 {
 	return ActiveInputMethod == ECommonInputType::Gamepad;
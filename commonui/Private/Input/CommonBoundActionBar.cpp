@@ -2,21 +2,21 @@
 
 #include "Input/CommonBoundActionBar.h"
 #include "Input/CommonUIActionRouterBase.h"
+#include "Input/CommonDisplayedActionsModel.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/GameInstance.h"
 #include "TimerManager.h"
 #include "Editor/WidgetCompilerLog.h"
 #include "Input/UIActionRouterTypes.h"
+#include "CommonUIStats.h"
 
 #define LOCTEXT_NAMESPACE "CommonUI"
 
-bool bActionBarIgnoreOptOut = false;
-static FAutoConsoleVariableRef CVarActionBarIgnoreOptOut(
-	TEXT("ActionBar.IgnoreOptOut"),
-	bActionBarIgnoreOptOut,
-	TEXT("If true, the Bound Action Bar will display bindings whether or not they are configured bDisplayInReflector"),
-	ECVF_Default
-);
+DECLARE_CYCLE_STAT(TEXT("CommonBoundActionBar Refresh"), STAT_CommonBoundActionBar_Refresh, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonBoundActionBar Refreshes"), STAT_CommonBoundActionBar_Refreshes, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonBoundActionBar Entries Created"), STAT_CommonBoundActionBar_EntriesCreated, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonBoundActionBar Entries Reused"), STAT_CommonBoundActionBar_EntriesReused, STATGROUP_CommonUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CommonBoundActionBar Entries Rebound"), STAT_CommonBoundActionBar_EntriesRebound, STATGROUP_CommonUI);
 
 void UCommonBoundActionBar::SetDisplayOwningPlayerActionsOnly(bool bShouldOnlyDisplayOwningPlayerActions)
 {
@@ -68,9 +68,9 @@ void UCommonBoundActionBar::ReleaseSlateResources(bool bReleaseChildren)
 	{
 		for (const ULocalPlayer* LocalPlayer : GameInstance->GetLocalPlayers())
 		{
-			if (const UCommonUIActionRouterBase* ActionRouter = ULocalPlayer::GetSubsystem<UCommonUIActionRouterBase>(LocalPlayer))
+			if (TSharedPtr<FCommonDisplayedActionsModel> DisplayedActions = FCommonDisplayedActionsModel::Get(LocalPlayer))
 			{
-				ActionRouter->OnBoundActionsUpdated().RemoveAll(this);
+				DisplayedActions->OnDisplayedActionsChanged().RemoveAll(this);
 			}
 		}
 	}
@@ -107,120 +107,102 @@ void UCommonBoundActionBar::HandleBoundActionsUpdated(bool bFromOwningPlayer)
 
 void UCommonBoundActionBar::HandleDeferredDisplayUpdate()
 {
-	bIsRefreshQueued = false;
+	SCOPE_CYCLE_COUNTER(STAT_CommonBoundActionBar_Refresh);
+	CSV_SCOPED_TIMING_STAT(CommonUI, ActionBarRefresh);
+	INC_DWORD_STAT(STAT_CommonBoundActionBar_Refreshes);
 
-	ResetInternal();
+	bIsRefreshQueued = false;
 
 	const UGameInstance* GameInstance = GetGameInstance();
 	check(GameInstance);
 	const ULocalPlayer* OwningLocalPlayer = GetOwningLocalPlayer();
 
-	// Sort the player list so our owner is at the end
-	TArray<ULocalPlayer*> SortedPlayers = GameInstance->GetLocalPlayers();
-	SortedPlayers.StableSort(
-		[&OwningLocalPlayer](const ULocalPlayer& PlayerA, const ULocalPlayer& PlayerB)
-		{
-			return &PlayerA != OwningLocalPlayer;
-		});
-
-	for (const ULocalPlayer* LocalPlayer : SortedPlayers)
+	TArray<FUIActionBindingHandle> DisplayedBindings;
+	if (IsEntryClassValid(ActionButtonClass))
 	{
-		if (LocalPlayer == OwningLocalPlayer || !bDisplayOwningPlayerActionsOnly)
+		// Our owner's actions always go at the end
+		if (!bDisplayOwningPlayerActionsOnly)
 		{
-			if (IsEntryClassValid(ActionButtonClass))
+			for (const ULocalPlayer* LocalPlayer : GameInstance->GetLocalPlayers())
 			{
-				if (const UCommonUIActionRouterBase* ActionRouter = ULocalPlayer::GetSubsystem<UCommonUIActionRouterBase>(LocalPlayer))
+				if (LocalPlayer != OwningLocalPlayer)
 				{
-					const UCommonInputSubsystem& InputSubsystem = ActionRouter->GetInputSubsystem();
-					const ECommonInputType PlayerInputType = InputSubsystem.GetCurrentInputType();
-					const FName& PlayerGamepadName = InputSubsystem.GetCurrentGamepadName();
-
-					TArray<FUIActionBindingHandle> FilteredBindings = ActionRouter->GatherActiveBindings().FilterByPredicate([PlayerInputType, PlayerGamepadName](const FUIActionBindingHandle& Handle)
-						{
-							if (TSharedPtr<FUIActionBinding> Binding = FUIActionBinding::FindBinding(Handle))
-							{
-								if (!Binding->bDisplayInActionBar && !bActionBarIgnoreOptOut)
-								{
-									return false;
-								}
-
-								if (FCommonInputActionDataBase* LegacyData = Binding->GetLegacyInputActionData())
-								{
-									if (!LegacyData->CanDisplayInReflector(PlayerInputType, PlayerGamepadName))
-									{
-										return false;
-									}
-								}
-								else
-								{
-									return false; //@todo(josh.gross) - allow non-legacy bindings
-								}
-
-								return true;
-							}
-
-							return false;
-						});
-
-					//Force Virtual_Back to one end of the list so Back actions are always consistent.
-					//Otherwise, order within a node is controlled by order of add/remove.
-					Algo::Sort(FilteredBindings, [PlayerInputType, PlayerGamepadName](const FUIActionBindingHandle& A, const FUIActionBindingHandle& B)
-					{
-						TSharedPtr<FUIActionBinding> BindingA = FUIActionBinding::FindBinding(A);
-						TSharedPtr<FUIActionBinding> BindingB = FUIActionBinding::FindBinding(B);
-
-						if (ensureMsgf((BindingA && BindingB), TEXT("The array filter above should enforce that there are no null bindings")))
-						{
-							FCommonInputActionDataBase* LegacyDataA = BindingA->GetLegacyInputActionData();
-							FCommonInputActionDataBase* LegacyDataB = BindingB->GetLegacyInputActionData();
-							
-							if (ensureMsgf((LegacyDataA && LegacyDataB), TEXT("Non-legacy bindings not displayed yet -- array filter enforces they are not included")))
-							{
-								FKey KeyA = LegacyDataA->GetInputTypeInfo(PlayerInputType, PlayerGamepadName).GetKey();
-								FKey KeyB = LegacyDataB->GetInputTypeInfo(PlayerInputType, PlayerGamepadName).GetKey();
-							
-								// Fallback back to keyboard key when there is no key for touch
-								if (PlayerInputType == ECommonInputType::Touch)
-								{
-									if (!KeyA.IsValid())
-									{
-										KeyA = LegacyDataA->GetInputTypeInfo(ECommonInputType::MouseAndKeyboard, PlayerGamepadName).GetKey();
-									}
-
-									if (!KeyB.IsValid())
-									{
-										KeyB = LegacyDataB->GetInputTypeInfo(ECommonInputType::MouseAndKeyboard, PlayerGamepadName).GetKey();
-									}
-								}
-
-								bool bAIsBack = (KeyA == EKeys::Virtual_Back || KeyA == EKeys::Escape || KeyA == EKeys::Android_Back);
-								bool bBIsBack = (KeyB == EKeys::Virtual_Back || KeyB == EKeys::Escape || KeyB == EKeys::Android_Back);
-							
-								if (bAIsBack && !bBIsBack)
-								{
-									return false;
-								}
-							}
-
-							return GetTypeHash(BindingA->Handle) < GetTypeHash(BindingB->Handle);
-						}
-
-						return true; // A < B by default
-					});
-
-
-					for (FUIActionBindingHandle BindingHandle : FilteredBindings)
-					{
-						UCommonBoundActionButton* ActionButton = Cast<UCommonBoundActionButton>(CreateEntryInternal(ActionButtonClass));
-						if (ensure(ActionButton))
-						{
-							ActionButton->SetRepresentedAction(BindingHandle);
-						}
-					}
+					GatherDisplayedBindings(LocalPlayer, DisplayedBindings);
 				}
 			}
 		}
+		GatherDisplayedBindings(OwningLocalPlayer, DisplayedBindings);
 	}
+
+	UpdateEntries(DisplayedBindings);
+}
+
+void UCommonBoundActionBar::GatherDisplayedBindings(const ULocalPlayer* LocalPlayer, TArray<FUIActionBindingHandle>& OutBindings) const
+{
+	// The filtering and sorting is shared with every other bar displaying this player's actions
+	if (TSharedPtr<FCommonDisplayedActionsModel> DisplayedActions = FCommonDisplayedActionsModel::Get(LocalPlayer))
+	{
+		OutBindings.Append(DisplayedActions->GetDisplayedBindings());
+	}
+}
+
+void UCommonBoundActionBar::UpdateEntries(const TArray<FUIActionBindingHandle>& DisplayedBindings)
+{
+	// Pushing or popping a widget usually only adds or removes a binding or two, so existing entries are matched to the binding
+	// they already represent and left alone. An entry whose binding is no longer displayed is removed from wherever it is.
+	const TSet<FUIActionBindingHandle> DisplayedBindingSet(DisplayedBindings);
+
+	// Removing an entry releases it from the pool's active widgets, so we walk a copy of them
+	const TArray<UUserWidget*> ExistingEntries = GetAllEntries();
+	TArray<UCommonBoundActionButton*> SurvivingEntries;
+	for (UUserWidget* ExistingEntry : ExistingEntries)
+	{
+		UCommonBoundActionButton* ActionButton = ExistingEntry->IsA(ActionButtonClass) ? Cast<UCommonBoundActionButton>(ExistingEntry) : nullptr;
+		if (ActionButton && DisplayedBindingSet.Contains(ActionButton->GetRepresentedAction()))
+		{
+			SurvivingEntries.Add(ActionButton);
+		}
+		else
+		{
+			RemoveEntryInternal(ExistingEntry);
+		}
+	}
+
+	// The entry box can only append entries, so once a binding has to go in ahead of a surviving entry,
+	// the survivors from there on are rebound in their slots rather than moved.
+	int32 NumReused = 0;
+	int32 NumRebound = 0;
+	int32 NumCreated = 0;
+	for (int32 BindingIdx = 0; BindingIdx < DisplayedBindings.Num(); ++BindingIdx)
+	{
+		const FUIActionBindingHandle& BindingHandle = DisplayedBindings[BindingIdx];
+		if (SurvivingEntries.IsValidIndex(BindingIdx))
+		{
+			UCommonBoundActionButton* ActionButton = SurvivingEntries[BindingIdx];
+			if (ActionButton->GetRepresentedAction() == BindingHandle)
+			{
+				++NumReused;
+			}
+			else
+			{
+				ActionButton->SetRepresentedAction(BindingHandle);
+				++NumRebound;
+			}
+		}
+		else
+		{
+			UCommonBoundActionButton* ActionButton = Cast<UCommonBoundActionButton>(CreateEntryInternal(ActionButtonClass));
+			if (ensure(ActionButton))
+			{
+				ActionButton->SetRepresentedAction(BindingHandle);
+				++NumCreated;
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_CommonBoundActionBar_EntriesCreated, NumCreated);
+	INC_DWORD_STAT_BY(STAT_CommonBoundActionBar_EntriesReused, NumReused);
+	INC_DWORD_STAT_BY(STAT_CommonBoundActionBar_EntriesRebound, NumRebound);
 }
 
 void UCommonBoundActionBar::HandlePlayerAdded(int32 PlayerIdx)
@@ -232,9 +214,9 @@ void UCommonBoundActionBar::HandlePlayerAdded(int32 PlayerIdx)
 
 void UCommonBoundActionBar::MonitorPlayerActions(const ULocalPlayer* NewPlayer)
 {
-	if (const UCommonUIActionRouterBase* ActionRouter = ULocalPlayer::GetSubsystem<UCommonUIActionRouterBase>(NewPlayer))
+	if (TSharedPtr<FCommonDisplayedActionsModel> DisplayedActions = FCommonDisplayedActionsModel::Get(NewPlayer))
 	{
-		ActionRouter->OnBoundActionsUpdated().AddUObject(this, &UCommonBoundActionBar::HandleBoundActionsUpdated, NewPlayer == GetOwningLocalPlayer());
+		DisplayedActions->OnDisplayedActionsChanged().AddUObject(this, &UCommonBoundActionBar::HandleBoundActionsUpdated, NewPlayer == GetOwningLocalPlayer());
 	}
 }
 
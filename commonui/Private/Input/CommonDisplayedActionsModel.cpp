@@ -0,0 +1,140 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Input/CommonDisplayedActionsModel.h"
+#include "Input/CommonUIActionRouterBase.h"
+#include "Input/UIActionRouterTypes.h"
+#include "CommonInputSubsystem.h"
+#include "Engine/LocalPlayer.h"
+#include "HAL/IConsoleManager.h"
+
+bool bActionBarIgnoreOptOut = false;
+static FAutoConsoleVariableRef CVarActionBarIgnoreOptOut(
+	TEXT("ActionBar.IgnoreOptOut"),
+	bActionBarIgnoreOptOut,
+	TEXT("If true, the Bound Action Bar will display bindings whether or not they are configured bDisplayInReflector"),
+	ECVF_Default
+);
+
+//////////////////////////////////////////////////////////////////////////
+// UCommonDisplayedActionsSubsystem
+//////////////////////////////////////////////////////////////////////////
+
+void UCommonDisplayedActionsSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+
+	// The router is deinitialized alongside us, so the model has to let go of it now rather than whenever the last reference is dropped
+	Model.Reset();
+}
+
+TSharedPtr<FCommonDisplayedActionsModel> UCommonDisplayedActionsSubsystem::GetModel()
+{
+	if (!Model)
+	{
+		if (const UCommonUIActionRouterBase* Router = ULocalPlayer::GetSubsystem<UCommonUIActionRouterBase>(GetLocalPlayer<ULocalPlayer>()))
+		{
+			Model = MakeShared<FCommonDisplayedActionsModel>(*Router);
+		}
+	}
+	return Model;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FCommonDisplayedActionsModel
+//////////////////////////////////////////////////////////////////////////
+
+TSharedPtr<FCommonDisplayedActionsModel> FCommonDisplayedActionsModel::Get(const ULocalPlayer* LocalPlayer)
+{
+	UCommonDisplayedActionsSubsystem* DisplayedActionsSubsystem = ULocalPlayer::GetSubsystem<UCommonDisplayedActionsSubsystem>(LocalPlayer);
+	return DisplayedActionsSubsystem ? DisplayedActionsSubsystem->GetModel() : nullptr;
+}
+
+FCommonDisplayedActionsModel::FCommonDisplayedActionsModel(const UCommonUIActionRouterBase& InActionRouter)
+	: ActionRouter(&InActionRouter)
+{
+	InActionRouter.OnBoundActionsUpdated().AddRaw(this, &FCommonDisplayedActionsModel::HandleBoundActionsUpdated);
+}
+
+FCommonDisplayedActionsModel::~FCommonDisplayedActionsModel()
+{
+	if (const UCommonUIActionRouterBase* Router = ActionRouter.Get())
+	{
+		Router->OnBoundActionsUpdated().RemoveAll(this);
+	}
+}
+
+const TArray<FUIActionBindingHandle>& FCommonDisplayedActionsModel::GetDisplayedBindings()
+{
+	static const TArray<FUIActionBindingHandle> NoBindings;
+
+	const UCommonUIActionRouterBase* Router = ActionRouter.Get();
+	if (!Router)
+	{
+		return NoBindings;
+	}
+
+	const UCommonInputSubsystem& InputSubsystem = Router->GetInputSubsystem();
+	const TPair<ECommonInputType, FName> InputKey(InputSubsystem.GetCurrentInputType(), InputSubsystem.GetCurrentGamepadName());
+	if (const TArray<FUIActionBindingHandle>* CachedBindings = CachedBindingsByInput.Find(InputKey))
+	{
+		return *CachedBindings;
+	}
+
+	TArray<FUIActionBindingHandle>& DisplayedBindings = CachedBindingsByInput.Add(InputKey);
+	GatherDisplayedBindings(InputKey.Key, InputKey.Value, DisplayedBindings);
+	return DisplayedBindings;
+}
+
+void FCommonDisplayedActionsModel::HandleBoundActionsUpdated()
+{
+	CachedBindingsByInput.Reset();
+	OnDisplayedActionsChangedEvent.Broadcast();
+}
+
+void FCommonDisplayedActionsModel::GatherDisplayedBindings(ECommonInputType InputType, const FName& GamepadName, TArray<FUIActionBindingHandle>& OutBindings) const
+{
+	// Everything the sort needs is worked out once per binding here, so the sort itself only compares integers
+	struct FSortableBinding
+	{
+		FUIActionBindingHandle Handle;
+		uint64 SortKey;
+	};
+	TArray<FSortableBinding, TInlineAllocator<16>> SortableBindings;
+
+	for (const FUIActionBindingHandle& Handle : ActionRouter->GatherActiveBindings())
+	{
+		TSharedPtr<FUIActionBinding> Binding = FUIActionBinding::FindBinding(Handle);
+		if (!Binding || (!Binding->bDisplayInActionBar && !bActionBarIgnoreOptOut))
+		{
+			continue;
+		}
+
+		FCommonInputActionDataBase* LegacyData = Binding->GetLegacyInputActionData();
+		if (!LegacyData || !LegacyData->CanDisplayInReflector(InputType, GamepadName))
+		{
+			//@todo(josh.gross) - allow non-legacy bindings
+			continue;
+		}
+
+		FKey Key = LegacyData->GetInputTypeInfo(InputType, GamepadName).GetKey();
+
+		// Fallback back to keyboard key when there is no key for touch
+		if (InputType == ECommonInputType::Touch && !Key.IsValid())
+		{
+			Key = LegacyData->GetInputTypeInfo(ECommonInputType::MouseAndKeyboard, GamepadName).GetKey();
+		}
+
+		//Force Virtual_Back to one end of the list so Back actions are always consistent.
+		//Otherwise, order within a node is controlled by order of add/remove.
+		const bool bIsBack = Key == EKeys::Virtual_Back || Key == EKeys::Escape || Key == EKeys::Android_Back;
+		SortableBindings.Add({ Handle, ((uint64)bIsBack << 32) | GetTypeHash(Binding->Handle) });
+	}
+
+	Algo::SortBy(SortableBindings, &FSortableBinding::SortKey);
+
+	OutBindings.Reset(SortableBindings.Num());
+	for (const FSortableBinding& SortableBinding : SortableBindings)
+	{
+		OutBindings.Add(SortableBinding.Handle);
+	}
+}
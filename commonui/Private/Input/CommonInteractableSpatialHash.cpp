@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Input/CommonInteractableSpatialHash.h"
+#include "CommonUIPrivatePCH.h"
+#include "Components/Widget.h"
+
+FCommonInteractableSpatialHash::FCommonInteractableSpatialHash(float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.f))
+{
+}
+
+void FCommonInteractableSpatialHash::UpdateWidget(const UWidget& Widget, const FSlateRect& AbsoluteRect)
+{
+	if (const int32* ExistingIndex = EntryIndicesByWidget.Find(&Widget))
+	{
+		FEntry& Entry = Entries[*ExistingIndex];
+		if (Entry.Rect == AbsoluteRect)
+		{
+			return;
+		}
+
+		const FIntRect NewCellBounds = GetCellBounds(AbsoluteRect);
+		if (NewCellBounds != Entry.CellBounds)
+		{
+			RemoveFromCells(*ExistingIndex, Entry.CellBounds);
+			AddToCells(*ExistingIndex, NewCellBounds);
+			Entry.CellBounds = NewCellBounds;
+		}
+		Entry.Rect = AbsoluteRect;
+		return;
+	}
+
+	FEntry NewEntry;
+	NewEntry.Widget = &Widget;
+	NewEntry.Rect = AbsoluteRect;
+	NewEntry.CellBounds = GetCellBounds(AbsoluteRect);
+
+	const int32 EntryIndex = Entries.Add(NewEntry);
+	EntryIndicesByWidget.Add(&Widget, EntryIndex);
+	AddToCells(EntryIndex, NewEntry.CellBounds);
+}
+
+void FCommonInteractableSpatialHash::RemoveWidget(const UWidget& Widget)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (EntryIndicesByWidget.RemoveAndCopyValue(&Widget, EntryIndex))
+	{
+		RemoveFromCells(EntryIndex, Entries[EntryIndex].CellBounds);
+		Entries.RemoveAt(EntryIndex);
+	}
+}
+
+void FCommonInteractableSpatialHash::Reset()
+{
+	Entries.Reset();
+	EntryIndicesByWidget.Reset();
+	Cells.Reset();
+}
+
+const UWidget* FCommonInteractableSpatialHash::FindWidgetAt(const FVector2D& AbsolutePosition) const
+{
+	const TArray<int32>* CellEntries = Cells.Find(GetCell(AbsolutePosition));
+	if (!CellEntries)
+	{
+		return nullptr;
+	}
+
+	// Interactables can be nested (ex: a button within a list row button), in which case the innermost one is the one under the cursor
+	const UWidget* FoundWidget = nullptr;
+	float FoundArea = MAX_flt;
+	for (const int32 EntryIndex : *CellEntries)
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+		if (Entry.Rect.ContainsPoint(AbsolutePosition))
+		{
+			const FVector2D RectSize = Entry.Rect.GetSize();
+			const float Area = RectSize.X * RectSize.Y;
+			if (Area < FoundArea)
+			{
+				if (const UWidget* Widget = Entry.Widget.Get())
+				{
+					FoundWidget = Widget;
+					FoundArea = Area;
+				}
+			}
+		}
+	}
+	return FoundWidget;
+}
+
+const UWidget* FCommonInteractableSpatialHash::FindNearestWidget(const FVector2D& AbsolutePosition, float MaxDistance) const
+{
+	const FIntRect SearchBounds = GetCellBounds(FSlateRect(AbsolutePosition - FVector2D(MaxDistance), AbsolutePosition + FVector2D(MaxDistance)));
+
+	const UWidget* NearestWidget = nullptr;
+	float NearestDistanceSq = FMath::Square(MaxDistance);
+	for (int32 CellY = SearchBounds.Min.Y; CellY <= SearchBounds.Max.Y; ++CellY)
+	{
+		for (int32 CellX = SearchBounds.Min.X; CellX <= SearchBounds.Max.X; ++CellX)
+		{
+			const TArray<int32>* CellEntries = Cells.Find(FIntPoint(CellX, CellY));
+			if (!CellEntries)
+			{
+				continue;
+			}
+
+			for (const int32 EntryIndex : *CellEntries)
+			{
+				const FEntry& Entry = Entries[EntryIndex];
+				const FVector2D ClosestPoint(
+					FMath::Clamp(AbsolutePosition.X, Entry.Rect.Left, Entry.Rect.Right),
+					FMath::Clamp(AbsolutePosition.Y, Entry.Rect.Top, Entry.Rect.Bottom));
+
+				const float DistanceSq = FVector2D::DistSquared(ClosestPoint, AbsolutePosition);
+				if (DistanceSq <= NearestDistanceSq)
+				{
+					if (const UWidget* Widget = Entry.Widget.Get())
+					{
+						NearestWidget = Widget;
+						NearestDistanceSq = DistanceSq;
+					}
+				}
+			}
+		}
+	}
+	return NearestWidget;
+}
+
+FIntRect FCommonInteractableSpatialHash::GetCellBounds(const FSlateRect& Rect) const
+{
+	const FIntPoint MinCell = GetCell(FVector2D(Rect.Left, Rect.Top));
+	const FIntPoint MaxCell = GetCell(FVector2D(Rect.Right, Rect.Bottom));
+	return FIntRect(MinCell, MaxCell);
+}
+
+FIntPoint FCommonInteractableSpatialHash::GetCell(const FVector2D& Position) const
+{
+	return FIntPoint(FMath::FloorToInt(Position.X / CellSize), FMath::FloorToInt(Position.Y / CellSize));
+}
+
+void FCommonInteractableSpatialHash::AddToCells(int32 EntryIndex, const FIntRect& CellBounds)
+{
+	for (int32 CellY = CellBounds.Min.Y; CellY <= CellBounds.Max.Y; ++CellY)
+	{
+		for (int32 CellX = CellBounds.Min.X; CellX <= CellBounds.Max.X; ++CellX)
+		{
+			Cells.FindOrAdd(FIntPoint(CellX, CellY)).Add(EntryIndex);
+		}
+	}
+}
+
+void FCommonInteractableSpatialHash::RemoveFromCells(int32 EntryIndex, const FIntRect& CellBounds)
+{
+	for (int32 CellY = CellBounds.Min.Y; CellY <= CellBounds.Max.Y; ++CellY)
+	{
+		for (int32 CellX = CellBounds.Min.X; CellX <= CellBounds.Max.X; ++CellX)
+		{
+			const FIntPoint Cell(CellX, CellY);
+			if (TArray<int32>* CellEntries = Cells.Find(Cell))
+			{
+				CellEntries->RemoveSingleSwap(EntryIndex, false);
+				if (CellEntries->Num() == 0)
+				{
+					Cells.Remove(Cell);
+				}
+			}
+		}
+	}
+}
@@ -6,6 +6,11 @@
 #include "Input/UIActionBindingHandle.h"
 #include "CommonActivatableWidget.generated.h"
 
+class SBox;
+class SLoadGuard;
+class UScrollBox;
+class UListView;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnWidgetActivationChanged);
 
 /** 
@@ -63,6 +68,10 @@ public:
 
 	DECLARE_MULTICAST_DELEGATE_OneParam(FActivatableWidgetRebuildEvent, UCommonActivatableWidget&);
 	static FActivatableWidgetRebuildEvent OnRebuilding;
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FActivatableWidgetActivationEvent, UCommonActivatableWidget&);
+	/** Fires whenever any activatable widget is activated or deactivated */
+	static FActivatableWidgetActivationEvent OnActivationChanged;
 	
 	FSimpleMulticastDelegate& OnSlateReleased() const { return OnSlateReleasedEvent; }
 
@@ -71,6 +80,15 @@ public:
 	bool SetsVisibilityOnActivated() const { return bSetVisibilityOnActivated; }
 	bool SetsVisibilityOnDeactivated() const { return bSetVisibilityOnDeactivated; }
 
+	/** True while the widget's content is being built across several frames, during which activation is deferred */
+	bool IsBuildingAsynchronously() const { return AsyncBuildTickerHandle.IsValid(); }
+
+	/** Fires once a widget building asynchronously has finished building its content */
+	FSimpleMulticastDelegate& OnAsyncBuildComplete() const { return OnAsyncBuildCompleteEvent; }
+
+	/** True if the widget's content has released its Slate resources while deactivated, to be rebuilt upon activation */
+	bool IsSlateReleasedWhileDeactivated() const { return bIsSlateReleasedWhileDeactivated; }
+
 protected:
 	virtual TSharedRef<SWidget> RebuildWidget() override;
 	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
@@ -162,6 +180,28 @@ private:
 	UPROPERTY(EditAnywhere, Category = Activation, meta = (EditCondition = "bSetVisibilityOnDeactivated"))
 	ESlateVisibility DeactivatedVisibility = ESlateVisibility::Collapsed;
 
+	UPROPERTY(EditAnywhere, Category = Construction, meta = (InlineEditConditionToggle = "AsyncBuildFrameBudgetMs"))
+	bool bBuildAsynchronously = false;
+
+	/**
+	 * Milliseconds per frame to spend building this widget's content, which is built across as many frames as needed behind a loading spinner.
+	 * Activation (including auto-activation) is deferred until the content is complete.
+	 * Note that PreConstruct and Construct run before any of the content has been built, so logic there that reaches into the content's Slate
+	 * (or its geometry) should move to activation or OnAsyncBuildComplete instead.
+	 */
+	UPROPERTY(EditAnywhere, Category = Construction, meta = (EditCondition = "bBuildAsynchronously", ClampMin = 0.1))
+	float AsyncBuildFrameBudgetMs = 4.f;
+
+	UPROPERTY(EditAnywhere, Category = Activation, meta = (InlineEditConditionToggle = "SlateReleaseDelay"))
+	bool bReleaseSlateWhenDeactivated = false;
+
+	/**
+	 * Real-time seconds (unaffected by pausing or time dilation) this widget must remain deactivated before its content releases its Slate resources.
+	 * The content is rebuilt upon re-activation, with scroll offsets, list selections and the focus target restored.
+	 */
+	UPROPERTY(EditAnywhere, Category = Activation, meta = (EditCondition = "bReleaseSlateWhenDeactivated", ClampMin = 0))
+	float SlateReleaseDelay = 10.f;
+
 	/** Fires when the widget is activated. */
 	UPROPERTY(BlueprintAssignable, Category = Events, meta = (AllowPrivateAccess = true, DisplayName = "On Widget Activated"))
 	FOnWidgetActivationChanged BP_OnWidgetActivated;
@@ -177,6 +217,44 @@ private:
 	mutable FSimpleMulticastDelegate OnDeactivatedEvent;
 	mutable FSimpleMulticastDelegate OnSlateReleasedEvent;
 	mutable FSimpleMulticastDelegate OnRequestRefreshFocusEvent;
+	mutable FSimpleMulticastDelegate OnAsyncBuildCompleteEvent;
+
+	TSharedRef<SWidget> BuildContent();
+	bool HandleAsyncBuildTick(float DeltaTime);
+	void CancelAsyncBuild();
+
+	/** Widgets of the tree, children before parents, yet to be built by the async build */
+	TArray<TWeakObjectPtr<UWidget>> PendingAsyncBuildWidgets;
+	int32 NextAsyncBuildIdx = 0;
+
+	/** Keeps what's been built so far alive until the root takes ownership of it */
+	TArray<TSharedRef<SWidget>> AsyncBuiltWidgets;
+
+	TSharedPtr<SLoadGuard> AsyncBuildGuard;
+	FDelegateHandle AsyncBuildTickerHandle;
+	double AsyncBuildStartTime = 0.;
+	int32 NumAsyncBuildFrames = 0;
+	bool bActivateWhenAsyncBuilt = false;
+
+	/** What's needed to put the rebuilt content back the way it was when its Slate resources were released */
+	struct FSlateRestoreState
+	{
+		TArray<TPair<TWeakObjectPtr<UScrollBox>, float>> ScrollBoxOffsets;
+		TArray<TPair<TWeakObjectPtr<UListView>, float>> ListViewOffsets;
+		TArray<TPair<TWeakObjectPtr<UListView>, TArray<TWeakObjectPtr<UObject>>>> ListViewSelections;
+		TWeakObjectPtr<UWidget> FocusTarget;
+	};
+
+	void ReleaseDeactivatedSlate();
+	void RestoreDeactivatedSlate();
+	bool HandleSlateReleaseTick(float DeltaTime);
+	void ClearSlateReleaseTicker();
+
+	/** Holds the content built by RebuildWidget, so the content can be released and rebuilt without disturbing our parent */
+	TSharedPtr<SBox> ReleasableContentBox;
+	FSlateRestoreState SlateRestoreState;
+	FDelegateHandle SlateReleaseTickerHandle;
+	bool bIsSlateReleasedWhileDeactivated = false;
 
 protected:
 	virtual void InternalProcessActivation();
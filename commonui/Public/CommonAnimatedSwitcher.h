@@ -10,6 +10,10 @@
 
 class SOverlay;
 class SSpacer;
+class SBox;
+
+/** Readies a child ahead of it being built (ex: async loading the classes & assets it needs). OnPrepared must be executed once done. */
+DECLARE_DELEGATE_TwoParams(FPrepareLazyChild, UWidget* /*Child*/, FSimpleDelegate /*OnPrepared*/);
 
 UCLASS()
 class COMMONUI_API UCommonAnimatedSwitcher : public UWidgetSwitcher
@@ -44,6 +48,7 @@ protected:
 	virtual void HandleSlateActiveIndexChanged(int32 ActiveIndex);
 
 	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual void OnSlotRemoved(UPanelSlot* InSlot) override;
 
 	virtual void HandleOutgoingWidget() {};
 
@@ -52,6 +57,9 @@ public:
 	DECLARE_EVENT_TwoParams(UCommonAnimatedSwitcher, FOnActiveIndexChanged, UWidget*, int32)
 	FOnActiveIndexChanged OnActiveWidgetIndexChanged;
 
+	/** Optional hook given each lazily built child before it's built ahead of time as a neighbour of the active child */
+	FPrepareLazyChild PrepareLazyChild;
+
 protected:
 	/** The type of transition to play between widgets */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Transition")
@@ -65,6 +73,14 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Transition")
 	float TransitionDuration;
 
+	/**
+	 * If set, the Slate widget of each child is only built once that child first becomes active, or is about to as a neighbour of the active child.
+	 * Children added after construction are built immediately as usual.
+	 * Note that changes to the slot layout (padding & alignment) of a lazily built child are not applied until the switcher is rebuilt.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Performance")
+	bool bBuildChildrenLazily = false;
+
 	TSharedPtr<SOverlay> MyOverlay;
 	TSharedPtr<SSpacer> MyInputGuard;
 	TSharedPtr<SCommonAnimatedSwitcher> MyAnimatedSwitcher;
@@ -77,4 +93,21 @@ protected:
 private:
 	void HandleSlateIsTransitioningChanged(bool bIsTransitioning);
 	void SetActiveWidgetIndex_Internal(int32 Index);
+
+	void BuildLazyChild(UPanelSlot* ChildSlot);
+	void PrefetchNeighbours(int32 Index);
+	void HandleLazyChildPrepared(TWeakObjectPtr<UPanelSlot> ChildSlot);
+	bool HandlePrefetchTick(float DeltaTime);
+
+	struct FLazyChild
+	{
+		TSharedRef<SBox> Container;
+		bool bIsBuilt = false;
+	};
+	TMap<UPanelSlot*, FLazyChild> LazyChildren;
+	TArray<TWeakObjectPtr<UPanelSlot>> PendingPrefetches;
+	FDelegateHandle PrefetchTickerHandle;
+
+	/** Time spent building children on demand, reported alongside the number never built once the switcher is released */
+	double LazyChildBuildTime = 0.;
 };
\ No newline at end of file
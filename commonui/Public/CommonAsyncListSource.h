@@ -0,0 +1,368 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "UObject/GCObject.h"
+#include "CommonNativeListItem.h"
+#include "CommonListView.h"
+#include "CommonTileView.h"
+
+namespace CommonAsyncListSource
+{
+	template <typename ItemType>
+	void AddReferencedItems(FReferenceCollector& Collector, TArray<ItemType>& Items) {}
+
+	template <typename ObjectType>
+	void AddReferencedItems(FReferenceCollector& Collector, TArray<ObjectType*>& Items)
+	{
+		Collector.AddReferencedObjects(Items);
+	}
+
+	/** Items are identified by address when diffing results from different snapshots, so workers never touch the items themselves */
+	template <typename ObjectType>
+	const void* GetItemKey(ObjectType* Item)
+	{
+		return Item;
+	}
+
+	template <typename ObjectType, ESPMode Mode>
+	const void* GetItemKey(const TSharedPtr<ObjectType, Mode>& Item)
+	{
+		return Item.Get();
+	}
+}
+
+/**
+ * Filters and sorts a collection of list items on worker threads, delivering the result (and what changed since the last result) on the game thread.
+ * Working out what changed happens on the worker too, so the game thread only copies out the result and applies the splices.
+ *
+ * Each request runs over an immutable snapshot of the source items and only ever produces indices into it, so items are never copied off the game thread.
+ * Starting a new request supersedes any request still in flight - superseded requests stop at their next cancellation check and their results are dropped.
+ *
+ * The filter and sort predicates run on worker threads: they must only read data that does not change while a request is in flight.
+ *
+ * Must be created, used and destroyed on the game thread. For UObject items, the source keeps the items of the current and in-flight snapshots referenced.
+ *
+ *	TSharedRef<FCommonAsyncObjectListSource, ESPMode::ThreadSafe> FriendsSource = MakeShared<FCommonAsyncObjectListSource, ESPMode::ThreadSafe>();
+ *	FriendsSource->BindToListView(*FriendsList);
+ *	FriendsSource->SetSourceItems(AllFriends);
+ *	...
+ *	FriendsSource->SetFilter([SearchString](UObject* const& Item) { return CastChecked<UFriendEntry>(Item)->DisplayName.Contains(SearchString); });
+ */
+template <typename ItemType>
+class TCommonAsyncListSource : public TSharedFromThis<TCommonAsyncListSource<ItemType>, ESPMode::ThreadSafe>, public FGCObject
+{
+public:
+	typedef TFunction<bool(const ItemType&)> FFilterPredicate;
+	typedef TFunction<bool(const ItemType&, const ItemType&)> FSortPredicate;
+
+	struct FResult
+	{
+		/** The filtered and sorted items */
+		TArray<ItemType> Items;
+
+		/** The items that were not in the previous result and the items that have left it */
+		TArray<ItemType> AddedItems;
+		TArray<ItemType> RemovedItems;
+	};
+	typedef TDelegate<void(const FResult&)> FOnResultReady;
+
+	virtual ~TCommonAsyncListSource()
+	{
+		// Anything still running will find it has been superseded and the game thread callback won't find us
+		LatestRequestSerial->Increment();
+	}
+
+	/** Replaces the collection being filtered and sorted */
+	void SetSourceItems(const TArray<ItemType>& InItems, bool bRequestUpdate = true)
+	{
+		check(IsInGameThread());
+		SourceItems = MakeShared<TArray<ItemType>, ESPMode::ThreadSafe>(InItems);
+		if (bRequestUpdate)
+		{
+			RequestUpdate();
+		}
+	}
+
+	/** Sets the predicate deciding which items pass. Runs on worker threads. */
+	void SetFilter(FFilterPredicate InFilterPredicate, bool bRequestUpdate = true)
+	{
+		check(IsInGameThread());
+		FilterPredicate = MoveTemp(InFilterPredicate);
+		if (bRequestUpdate)
+		{
+			RequestUpdate();
+		}
+	}
+
+	/** Sets the (stable) ordering of items that pass the filter. Runs on worker threads. */
+	void SetSortPredicate(FSortPredicate InSortPredicate, bool bRequestUpdate = true)
+	{
+		check(IsInGameThread());
+		SortPredicate = MoveTemp(InSortPredicate);
+		if (bRequestUpdate)
+		{
+			RequestUpdate();
+		}
+	}
+
+	/** Starts filtering and sorting the current source items, superseding any request still in flight */
+	void RequestUpdate()
+	{
+		check(IsInGameThread());
+
+		const int32 RequestSerial = LatestRequestSerial->Increment();
+		InFlightSnapshots.Add(SourceItems);
+
+		// Everything the worker touches is immutable for the lifetime of the request
+		FItemArrayPtr Snapshot = SourceItems;
+		FItemArrayPtr PreviousSnapshot = AppliedSnapshot;
+		const FIndexArrayPtr PreviousIndices = AppliedIndices;
+		const FFilterPredicate Filter = FilterPredicate;
+		const FSortPredicate Sort = SortPredicate;
+		const TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> LatestSerial = LatestRequestSerial;
+		const TWeakPtr<TCommonAsyncListSource, ESPMode::ThreadSafe> WeakThis = this->AsShared();
+
+		Async(EAsyncExecution::ThreadPool, [Snapshot, PreviousSnapshot, PreviousIndices, Filter, Sort, LatestSerial, RequestSerial, WeakThis]() mutable
+		{
+			TSharedRef<FWorkerResult, ESPMode::ThreadSafe> WorkerResult = MakeShared<FWorkerResult, ESPMode::ThreadSafe>();
+			WorkerResult->bCompleted = FilterAndSort(*Snapshot, Filter, Sort, RequestSerial, *LatestSerial, *WorkerResult)
+				&& DiffAgainstPrevious(*Snapshot, PreviousSnapshot.Get(), PreviousIndices.Get(), RequestSerial, *LatestSerial, *WorkerResult);
+
+			// Hand our references to the snapshots back to the game thread, so native items are never released on a worker
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Snapshot = MoveTemp(Snapshot), PreviousSnapshot = MoveTemp(PreviousSnapshot), RequestSerial, WorkerResult]()
+			{
+				if (TSharedPtr<TCommonAsyncListSource, ESPMode::ThreadSafe> StrongThis = WeakThis.Pin())
+				{
+					StrongThis->HandleRequestFinished(Snapshot, PreviousSnapshot, RequestSerial, *WorkerResult);
+				}
+			});
+		});
+	}
+
+	/** @return True while the most recent request has not delivered its result */
+	bool IsUpdatePending() const { return LatestRequestSerial->GetValue() != AppliedRequestSerial; }
+
+	const TArray<ItemType>& GetSourceItems() const { return *SourceItems; }
+
+	FOnResultReady& OnResultReady() { return OnResultReadyDelegate; }
+
+	/** Applies every result to the given list view as an incremental update. Only available for UObject lists. */
+	void BindToListView(UCommonListView& ListView)
+	{
+		OnResultReadyDelegate.BindWeakLambda(&ListView, [ListViewPtr = &ListView](const FResult& Result)
+		{
+			ListViewPtr->UpdateListItemsWithDiff(Result.Items, Result.AddedItems, Result.RemovedItems);
+		});
+	}
+
+	/** Applies every result to the given tile view as an incremental update. Only available for UObject lists. */
+	void BindToTileView(UCommonTileView& TileView)
+	{
+		OnResultReadyDelegate.BindWeakLambda(&TileView, [TileViewPtr = &TileView](const FResult& Result)
+		{
+			TileViewPtr->UpdateListItemsWithDiff(Result.Items, Result.AddedItems, Result.RemovedItems);
+		});
+	}
+
+	// FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		CommonAsyncListSource::AddReferencedItems(Collector, *SourceItems);
+		for (const FItemArrayPtr& Snapshot : InFlightSnapshots)
+		{
+			CommonAsyncListSource::AddReferencedItems(Collector, *Snapshot);
+		}
+	}
+	// End FGCObject interface
+
+private:
+	typedef TSharedPtr<TArray<ItemType>, ESPMode::ThreadSafe> FItemArrayPtr;
+	typedef TSharedPtr<const TArray<int32>, ESPMode::ThreadSafe> FIndexArrayPtr;
+
+	/** How many items a worker filters between checks for having been superseded */
+	static const int32 CancellationCheckInterval = 1024;
+
+	struct FWorkerResult
+	{
+		TArray<int32> Indices;
+
+		/** Indices into the new snapshot of the items that were added, and into the previous snapshot of the items that were removed */
+		TArray<int32> AddedIndices;
+		TArray<int32> RemovedIndices;
+		bool bCompleted = false;
+	};
+
+	/** Runs on a worker thread. Returns false if the request was superseded before it finished. */
+	static bool FilterAndSort(const TArray<ItemType>& Items, const FFilterPredicate& Filter, const FSortPredicate& Sort,
+		int32 RequestSerial, const FThreadSafeCounter& LatestSerial, FWorkerResult& OutResult)
+	{
+		auto IsSuperseded = [&LatestSerial, RequestSerial]() { return LatestSerial.GetValue() != RequestSerial; };
+
+		TArray<int32>& Indices = OutResult.Indices;
+		Indices.Reserve(Items.Num());
+		for (int32 ItemIdx = 0; ItemIdx < Items.Num(); ++ItemIdx)
+		{
+			if (ItemIdx % CancellationCheckInterval == 0 && IsSuperseded())
+			{
+				return false;
+			}
+
+			if (!Filter || Filter(Items[ItemIdx]))
+			{
+				Indices.Add(ItemIdx);
+			}
+		}
+
+		if (Sort)
+		{
+			if (IsSuperseded())
+			{
+				return false;
+			}
+			Indices.StableSort([&Items, &Sort](int32 IndexA, int32 IndexB) { return Sort(Items[IndexA], Items[IndexB]); });
+		}
+
+		return !IsSuperseded();
+	}
+
+	/** Runs on a worker thread, after FilterAndSort. Returns false if the request was superseded before it finished. */
+	static bool DiffAgainstPrevious(const TArray<ItemType>& Items, const TArray<ItemType>* PreviousItems, const TArray<int32>* PreviousIndices,
+		int32 RequestSerial, const FThreadSafeCounter& LatestSerial, FWorkerResult& OutResult)
+	{
+		const TArray<int32>& Indices = OutResult.Indices;
+		if (!PreviousItems || !PreviousIndices)
+		{
+			OutResult.AddedIndices = Indices;
+			return LatestSerial.GetValue() == RequestSerial;
+		}
+
+		if (PreviousItems == &Items)
+		{
+			// Both results index the same snapshot, so the diff is a pair of bit lookups per item
+			TBitArray<> InPreviousResult(false, Items.Num());
+			for (int32 PreviousIdx : *PreviousIndices)
+			{
+				InPreviousResult[PreviousIdx] = true;
+			}
+
+			TBitArray<> InNewResult(false, Items.Num());
+			for (int32 NewIdx : Indices)
+			{
+				InNewResult[NewIdx] = true;
+				if (!InPreviousResult[NewIdx])
+				{
+					OutResult.AddedIndices.Add(NewIdx);
+				}
+			}
+
+			for (int32 PreviousIdx : *PreviousIndices)
+			{
+				if (!InNewResult[PreviousIdx])
+				{
+					OutResult.RemovedIndices.Add(PreviousIdx);
+				}
+			}
+		}
+		else
+		{
+			// The source items were replaced, so match the two results up by item address
+			TSet<const void*> PreviousKeys;
+			PreviousKeys.Reserve(PreviousIndices->Num());
+			for (int32 PreviousIdx : *PreviousIndices)
+			{
+				PreviousKeys.Add(CommonAsyncListSource::GetItemKey((*PreviousItems)[PreviousIdx]));
+			}
+
+			if (LatestSerial.GetValue() != RequestSerial)
+			{
+				return false;
+			}
+
+			TSet<const void*> NewKeys;
+			NewKeys.Reserve(Indices.Num());
+			for (int32 NewIdx : Indices)
+			{
+				const void* NewKey = CommonAsyncListSource::GetItemKey(Items[NewIdx]);
+				NewKeys.Add(NewKey);
+				if (!PreviousKeys.Contains(NewKey))
+				{
+					OutResult.AddedIndices.Add(NewIdx);
+				}
+			}
+
+			for (int32 PreviousIdx : *PreviousIndices)
+			{
+				if (!NewKeys.Contains(CommonAsyncListSource::GetItemKey((*PreviousItems)[PreviousIdx])))
+				{
+					OutResult.RemovedIndices.Add(PreviousIdx);
+				}
+			}
+		}
+
+		return LatestSerial.GetValue() == RequestSerial;
+	}
+
+	void HandleRequestFinished(const FItemArrayPtr& Snapshot, const FItemArrayPtr& PreviousSnapshot, int32 RequestSerial, FWorkerResult& WorkerResult)
+	{
+		InFlightSnapshots.RemoveSingleSwap(Snapshot);
+
+		if (!WorkerResult.bCompleted || RequestSerial != LatestRequestSerial->GetValue())
+		{
+			return;
+		}
+
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_TCommonAsyncListSource_ApplyResult);
+
+		const TArray<ItemType>& Items = *Snapshot;
+		FResult Result;
+		Result.Items.Reserve(WorkerResult.Indices.Num());
+		for (int32 ItemIdx : WorkerResult.Indices)
+		{
+			Result.Items.Add(Items[ItemIdx]);
+		}
+
+		Result.AddedItems.Reserve(WorkerResult.AddedIndices.Num());
+		for (int32 ItemIdx : WorkerResult.AddedIndices)
+		{
+			Result.AddedItems.Add(Items[ItemIdx]);
+		}
+
+		if (WorkerResult.RemovedIndices.Num() > 0)
+		{
+			const TArray<ItemType>& PreviousItems = *PreviousSnapshot;
+			Result.RemovedItems.Reserve(WorkerResult.RemovedIndices.Num());
+			for (int32 ItemIdx : WorkerResult.RemovedIndices)
+			{
+				Result.RemovedItems.Add(PreviousItems[ItemIdx]);
+			}
+		}
+
+		AppliedSnapshot = Snapshot;
+		AppliedIndices = MakeShared<const TArray<int32>, ESPMode::ThreadSafe>(MoveTemp(WorkerResult.Indices));
+		AppliedRequestSerial = RequestSerial;
+
+		OnResultReadyDelegate.ExecuteIfBound(Result);
+	}
+
+	FItemArrayPtr SourceItems = MakeShared<TArray<ItemType>, ESPMode::ThreadSafe>();
+	FFilterPredicate FilterPredicate;
+	FSortPredicate SortPredicate;
+
+	/** Snapshots still being read by workers, including superseded requests that haven't noticed yet */
+	TArray<FItemArrayPtr> InFlightSnapshots;
+
+	/** The snapshot and indices of the last result delivered, which the next request diffs against */
+	FItemArrayPtr AppliedSnapshot;
+	FIndexArrayPtr AppliedIndices;
+	int32 AppliedRequestSerial = 0;
+
+	TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> LatestRequestSerial = MakeShared<FThreadSafeCounter, ESPMode::ThreadSafe>();
+
+	FOnResultReady OnResultReadyDelegate;
+};
+
+typedef TCommonAsyncListSource<UObject*> FCommonAsyncObjectListSource;
+typedef TCommonAsyncListSource<TSharedPtr<FCommonNativeListItem>> FCommonAsyncNativeListSource;
@@ -287,6 +287,7 @@ public:
 	virtual bool Initialize() override;
 	virtual void SetIsEnabled(bool bInIsEnabled) override;
 	virtual bool NativeIsInteractable() const override;
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 	// End of UUserWidget interface
 	
 	/** Disables this button with a reason (use instead of SetIsEnabled) */
@@ -428,6 +429,19 @@ public:
 	DECLARE_EVENT_OneParam(UCommonButtonBase, FOnIsSelectedChanged, bool);
 	FOnIsSelectedChanged& OnIsSelectedChanged() const { return OnIsSelectedChangedEvent; }
 
+	DECLARE_MULTICAST_DELEGATE_OneParam(FCommonButtonLifetimeEvent, UCommonButtonBase&);
+	/** Fire whenever any button is constructed or destructed, for systems that track the interactables on screen (ex: the analog cursor) */
+	static FCommonButtonLifetimeEvent OnButtonConstructed;
+	static FCommonButtonLifetimeEvent OnButtonDestructed;
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FCommonButtonPaintEvent, const UCommonButtonBase&);
+	/** Fires whenever any button is painted somewhere other than where it was last painted, or is painted again after going a frame or more without */
+	static FCommonButtonPaintEvent OnButtonPaintedRectChanged;
+
+	/** The frame this button was last painted in, and the absolute rect it was painted at */
+	uint64 GetLastPaintFrame() const { return LastPaintFrame; }
+	const FSlateRect& GetLastPaintedRect() const { return LastPaintedRect; }
+
 protected:
 	virtual UCommonButtonInternalBase* ConstructInternalButton();
 
@@ -733,6 +747,9 @@ private:
 
 	mutable FOnIsSelectedChanged OnIsSelectedChangedEvent;
 
+	mutable uint64 LastPaintFrame = 0;
+	mutable FSlateRect LastPaintedRect;
+
 protected:
 	/**
 	 * Optionally bound widget for visualization behavior of an input action;
@@ -0,0 +1,398 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/SlateDelegates.h"
+
+/**
+ * Linearized (depth-first, expanded nodes only) representation of a tree that is maintained incrementally.
+ *
+ * The children of each node are requested once and cached along with the node's depth and expansion state.
+ * Expanding or collapsing a node splices only that node's visible descendants into or out of the linearized items,
+ * rather than walking every expanded node of the tree again.
+ *
+ * Children can also be provided asynchronously: if OnRequestChildrenAsync is bound and accepts an item, its children are
+ * supplied later (in as many batches as desired) via AppendChildren. Items it declines fall back to OnGetChildren.
+ */
+template <typename ItemType>
+class TCommonFlattenedTree
+{
+public:
+	typedef typename TSlateDelegates<ItemType>::FOnGetChildren FOnGetChildren;
+
+	/** Return true to take over populating the item's children with AppendChildren, over as many frames as needed */
+	typedef TDelegate<bool(ItemType)> FOnRequestChildrenAsync;
+
+	FOnGetChildren OnGetChildren;
+	FOnRequestChildrenAsync OnRequestChildrenAsync;
+
+	const TArray<ItemType>& GetLinearizedItems() const { return LinearizedItems; }
+	int32 GetNestingDepth(int32 LinearizedIndex) const { return LinearizedDepths.IsValidIndex(LinearizedIndex) ? LinearizedDepths[LinearizedIndex] : 0; }
+
+	/**
+	 * Which levels of wire pass the given item, sized to one bit per level up to and including the item's own depth.
+	 * A level's bit is set when the item's ancestor (or the item itself) at that depth has a later sibling.
+	 * Only worked out when asked for, with one pass over the linearized items after each change.
+	 */
+	const TBitArray<>& GetWiresNeededByDepth(int32 LinearizedIndex) const
+	{
+		if (bLinearizedWiresDirty)
+		{
+			RebuildLinearizedWires();
+		}
+		return LinearizedWires.IsValidIndex(LinearizedIndex) ? LinearizedWires[LinearizedIndex] : NoWires;
+	}
+
+	/** Relinearizes the whole tree beneath the given roots. Cached children and expansion states are kept. */
+	void SetRootItems(const TArray<ItemType>& RootItems)
+	{
+		for (TPair<ItemType, FNodeInfo>& NodePair : Nodes)
+		{
+			NodePair.Value.LinearizedIndex = INDEX_NONE;
+		}
+
+		TArray<ItemType> NewItems;
+		TArray<int32> NewDepths;
+		for (const ItemType& RootItem : RootItems)
+		{
+			AppendVisibleSubtree(RootItem, 0, NewItems, NewDepths);
+		}
+
+		LinearizedItems.Reset();
+		LinearizedDepths.Reset();
+		InsertLinearized(0, NewItems, NewDepths);
+	}
+
+	/** Forgets all cached children and expansion states */
+	void Reset()
+	{
+		Nodes.Reset();
+		LinearizedItems.Reset();
+		LinearizedDepths.Reset();
+		bLinearizedWiresDirty = true;
+	}
+
+	bool IsItemExpanded(const ItemType& Item) const
+	{
+		const FNodeInfo* Node = Nodes.Find(Item);
+		return Node && Node->bExpanded;
+	}
+
+	bool DoesItemHaveChildren(const ItemType& Item) const
+	{
+		const FNodeInfo* Node = Nodes.Find(Item);
+		if (Node && Node->bChildrenCached)
+		{
+			return Node->Children.Num() > 0;
+		}
+		if (Node && Node->bChildrenPending)
+		{
+			// Children we haven't been given yet are assumed to exist
+			return true;
+		}
+		return HasChildrenUncached(Item);
+	}
+
+	/**
+	 * Expands or collapses a single item. The expansion state is remembered even if the item isn't currently visible.
+	 * @return True if the linearized items changed
+	 */
+	bool SetItemExpansion(const ItemType& Item, bool bShouldBeExpanded)
+	{
+		{
+			FNodeInfo& Node = Nodes.FindOrAdd(Item);
+			if (Node.bExpanded == bShouldBeExpanded)
+			{
+				return false;
+			}
+			Node.bExpanded = bShouldBeExpanded;
+		}
+
+		const int32 LinearizedIndex = FindLinearizedIndex(Item);
+		if (LinearizedIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		if (bShouldBeExpanded)
+		{
+			return InsertVisibleChildren(Item, LinearizedIndex);
+		}
+
+		const int32 NumDescendants = CountVisibleDescendants(LinearizedIndex);
+		RemoveLinearized(LinearizedIndex + 1, NumDescendants);
+		return NumDescendants > 0;
+	}
+
+	/**
+	 * Adds children to an item whose children are being provided asynchronously.
+	 * @param bIsFinalBatch True once the item has been given all of its children
+	 * @return True if the linearized items changed
+	 */
+	bool AppendChildren(const ItemType& ParentItem, TArrayView<const ItemType> NewChildren, bool bIsFinalBatch)
+	{
+		bool bParentExpanded = false;
+		{
+			FNodeInfo& ParentNode = Nodes.FindOrAdd(ParentItem);
+			ParentNode.Children.Append(NewChildren.GetData(), NewChildren.Num());
+			ParentNode.bChildrenPending = !bIsFinalBatch;
+			ParentNode.bChildrenCached = bIsFinalBatch;
+			bParentExpanded = ParentNode.bExpanded;
+		}
+
+		const int32 ParentIndex = bParentExpanded && !bIsRequestingChildren ? FindLinearizedIndex(ParentItem) : INDEX_NONE;
+		if (ParentIndex == INDEX_NONE || NewChildren.Num() == 0)
+		{
+			return false;
+		}
+
+		// The new children go after everything already visible beneath the parent
+		const int32 InsertIndex = ParentIndex + 1 + CountVisibleDescendants(ParentIndex);
+		const int32 ChildDepth = LinearizedDepths[ParentIndex] + 1;
+
+		TArray<ItemType> NewItems;
+		TArray<int32> NewDepths;
+		for (const ItemType& Child : NewChildren)
+		{
+			AppendVisibleSubtree(Child, ChildDepth, NewItems, NewDepths);
+		}
+		InsertLinearized(InsertIndex, NewItems, NewDepths);
+		return true;
+	}
+
+	/**
+	 * Discards the cached children of an item so that they are requested again. If the item is visible and expanded, its subtree is rebuilt immediately.
+	 * @return True if the linearized items changed
+	 */
+	bool InvalidateChildren(const ItemType& Item)
+	{
+		FNodeInfo* Node = Nodes.Find(Item);
+		if (!Node)
+		{
+			return false;
+		}
+
+		Node->Children.Reset();
+		Node->bChildrenCached = false;
+		Node->bChildrenPending = false;
+
+		const int32 LinearizedIndex = Node->bExpanded ? FindLinearizedIndex(Item) : INDEX_NONE;
+		if (LinearizedIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		const int32 NumDescendants = CountVisibleDescendants(LinearizedIndex);
+		RemoveLinearized(LinearizedIndex + 1, NumDescendants);
+		return InsertVisibleChildren(Item, LinearizedIndex) || NumDescendants > 0;
+	}
+
+private:
+	struct FNodeInfo
+	{
+		TArray<ItemType> Children;
+
+		/**
+		 * Where the item was last placed in the linearized items, or INDEX_NONE if it isn't visible.
+		 * Splices before the item shift it without this being updated, so it's a starting point for FindLinearizedIndex rather than exact.
+		 */
+		int32 LinearizedIndex = INDEX_NONE;
+
+		bool bExpanded = false;
+		bool bChildrenCached = false;
+		bool bChildrenPending = false;
+	};
+
+	/** Makes sure the children of the item have been requested. Children provided asynchronously may still be arriving afterwards. */
+	void CacheChildren(const ItemType& Item)
+	{
+		{
+			FNodeInfo& Node = Nodes.FindOrAdd(Item);
+			if (Node.bChildrenCached || Node.bChildrenPending)
+			{
+				return;
+			}
+			Node.bChildrenPending = true;
+		}
+
+		if (OnRequestChildrenAsync.IsBound())
+		{
+			// If the request is declined, the children are gathered synchronously below
+			// Batches appended from within the request are picked up by our caller rather than spliced in by AppendChildren
+			TGuardValue<bool> RequestGuard(bIsRequestingChildren, true);
+			if (OnRequestChildrenAsync.Execute(Item))
+			{
+				return;
+			}
+		}
+
+		TArray<ItemType> Children;
+		OnGetChildren.ExecuteIfBound(Item, Children);
+
+		FNodeInfo& CachedNode = Nodes.FindChecked(Item);
+		CachedNode.Children = MoveTemp(Children);
+		CachedNode.bChildrenCached = true;
+		CachedNode.bChildrenPending = false;
+	}
+
+	bool HasChildrenUncached(const ItemType& Item) const
+	{
+		const_cast<TCommonFlattenedTree*>(this)->CacheChildren(Item);
+
+		// Children being provided asynchronously are assumed to exist until the final batch says otherwise
+		const FNodeInfo& Node = Nodes.FindChecked(Item);
+		return Node.bChildrenPending || Node.Children.Num() > 0;
+	}
+
+	/** Appends the item and, if it's expanded, everything visible beneath it */
+	void AppendVisibleSubtree(const ItemType& Item, int32 Depth, TArray<ItemType>& OutItems, TArray<int32>& OutDepths)
+	{
+		OutItems.Add(Item);
+		OutDepths.Add(Depth);
+
+		if (!IsItemExpanded(Item))
+		{
+			return;
+		}
+		CacheChildren(Item);
+
+		// Recursing adds nodes to the map, so the parent node is looked up again for each child rather than held
+		for (int32 ChildIdx = 0; ChildIdx < Nodes.FindChecked(Item).Children.Num(); ++ChildIdx)
+		{
+			const ItemType Child = Nodes.FindChecked(Item).Children[ChildIdx];
+			AppendVisibleSubtree(Child, Depth + 1, OutItems, OutDepths);
+		}
+	}
+
+	bool InsertVisibleChildren(const ItemType& Item, int32 LinearizedIndex)
+	{
+		CacheChildren(Item);
+
+		const int32 ChildDepth = LinearizedDepths[LinearizedIndex] + 1;
+		TArray<ItemType> NewItems;
+		TArray<int32> NewDepths;
+		for (int32 ChildIdx = 0; ChildIdx < Nodes.FindChecked(Item).Children.Num(); ++ChildIdx)
+		{
+			const ItemType Child = Nodes.FindChecked(Item).Children[ChildIdx];
+			AppendVisibleSubtree(Child, ChildDepth, NewItems, NewDepths);
+		}
+
+		InsertLinearized(LinearizedIndex + 1, NewItems, NewDepths);
+		return NewItems.Num() > 0;
+	}
+
+	void InsertLinearized(int32 InsertIndex, const TArray<ItemType>& NewItems, const TArray<int32>& NewDepths)
+	{
+		LinearizedItems.Insert(NewItems, InsertIndex);
+		LinearizedDepths.Insert(NewDepths, InsertIndex);
+		bLinearizedWiresDirty = true;
+		for (int32 NewItemIdx = 0; NewItemIdx < NewItems.Num(); ++NewItemIdx)
+		{
+			Nodes.FindOrAdd(NewItems[NewItemIdx]).LinearizedIndex = InsertIndex + NewItemIdx;
+		}
+	}
+
+	void RemoveLinearized(int32 RemoveIndex, int32 NumToRemove)
+	{
+		for (int32 ItemIdx = RemoveIndex; ItemIdx < RemoveIndex + NumToRemove; ++ItemIdx)
+		{
+			if (FNodeInfo* Node = Nodes.Find(LinearizedItems[ItemIdx]))
+			{
+				Node->LinearizedIndex = INDEX_NONE;
+			}
+		}
+		LinearizedItems.RemoveAt(RemoveIndex, NumToRemove, false);
+		LinearizedDepths.RemoveAt(RemoveIndex, NumToRemove, false);
+		bLinearizedWiresDirty = true;
+	}
+
+	/**
+	 * Finds the item in the linearized items, starting from where it was last placed.
+	 * An item only ever moves by the size of the subtrees spliced in or out ahead of it, so searching outward from its
+	 * last index costs about as much as those splices did, and items that aren't visible are rejected immediately.
+	 */
+	int32 FindLinearizedIndex(const ItemType& Item)
+	{
+		FNodeInfo* Node = Nodes.Find(Item);
+		if (!Node || Node->LinearizedIndex == INDEX_NONE)
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 NumItems = LinearizedItems.Num();
+		const int32 LastIndex = Node->LinearizedIndex;
+		for (int32 Distance = 0; LastIndex - Distance >= 0 || LastIndex + Distance < NumItems; ++Distance)
+		{
+			const int32 IndexAfter = LastIndex + Distance;
+			if (IndexAfter < NumItems && LinearizedItems[IndexAfter] == Item)
+			{
+				Node->LinearizedIndex = IndexAfter;
+				return IndexAfter;
+			}
+
+			const int32 IndexBefore = LastIndex - Distance;
+			if (IndexBefore >= 0 && IndexBefore < NumItems && LinearizedItems[IndexBefore] == Item)
+			{
+				Node->LinearizedIndex = IndexBefore;
+				return IndexBefore;
+			}
+		}
+
+		Node->LinearizedIndex = INDEX_NONE;
+		return INDEX_NONE;
+	}
+
+	/** Walks the linearized items backwards, tracking at each depth whether a later sibling has been seen under the current parent */
+	void RebuildLinearizedWires() const
+	{
+		LinearizedWires.SetNum(LinearizedItems.Num());
+
+		TBitArray<> LaterSiblingAtDepth;
+		for (int32 ItemIdx = LinearizedDepths.Num() - 1; ItemIdx >= 0; --ItemIdx)
+		{
+			const int32 Depth = LinearizedDepths[ItemIdx];
+			if (LaterSiblingAtDepth.Num() < Depth + 1)
+			{
+				LaterSiblingAtDepth.Add(false, Depth + 1 - LaterSiblingAtDepth.Num());
+			}
+
+			TBitArray<>& Wires = LinearizedWires[ItemIdx];
+			Wires.Init(false, Depth + 1);
+			for (int32 Level = 0; Level <= Depth; ++Level)
+			{
+				Wires[Level] = LaterSiblingAtDepth[Level];
+			}
+
+			// Anything deeper that came after this item is in its own subtree, not beside the items before it
+			LaterSiblingAtDepth[Depth] = true;
+			for (int32 Level = Depth + 1; Level < LaterSiblingAtDepth.Num(); ++Level)
+			{
+				LaterSiblingAtDepth[Level] = false;
+			}
+		}
+
+		bLinearizedWiresDirty = false;
+	}
+
+	int32 CountVisibleDescendants(int32 LinearizedIndex) const
+	{
+		const int32 Depth = LinearizedDepths[LinearizedIndex];
+		int32 EndIndex = LinearizedIndex + 1;
+		while (EndIndex < LinearizedDepths.Num() && LinearizedDepths[EndIndex] > Depth)
+		{
+			++EndIndex;
+		}
+		return EndIndex - LinearizedIndex - 1;
+	}
+
+	TMap<ItemType, FNodeInfo> Nodes;
+	TArray<ItemType> LinearizedItems;
+	TArray<int32> LinearizedDepths;
+
+	mutable TArray<TBitArray<>> LinearizedWires;
+	mutable bool bLinearizedWiresDirty = true;
+	TBitArray<> NoWires;
+
+	bool bIsRequestingChildren = false;
+};
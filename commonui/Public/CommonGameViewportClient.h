@@ -8,6 +8,8 @@
 #include "Engine/GameViewportClient.h"
 #include "CommonGameViewportClient.generated.h"
 
+class UCommonUIActionRouterBase;
+
 DECLARE_DELEGATE_FourParams(FOnRerouteInputDelegate, int32 /* ControllerId */, FKey /* Key */, EInputEvent /* EventType */, FReply& /* Reply */);
 DECLARE_DELEGATE_FourParams(FOnRerouteAxisDelegate, int32 /* ControllerId */, FKey /* Key */, float /* Delta */, FReply& /* Reply */);
 DECLARE_DELEGATE_FiveParams(FOnRerouteTouchDelegate, int32 /* ControllerId */, uint32 /* TouchId */, ETouchType::Type /* TouchType */, const FVector2D& /* TouchLocation */, FReply& /* Reply */);
@@ -56,4 +58,23 @@ protected:
 	FOnRerouteTouchDelegate RerouteTouch;
 
 	FOnRerouteInputDelegate RerouteBlockedInput;
+
+	/** @return The action router of the local player with the given controller, if there is one */
+	UCommonUIActionRouterBase* FindActionRouter(int32 ControllerId);
+
+private:
+	void HandlePlayerAddedOrRemoved(int32 PlayerIndex);
+
+	struct FCachedActionRouter
+	{
+		TWeakObjectPtr<ULocalPlayer> LocalPlayer;
+		TWeakObjectPtr<UCommonUIActionRouterBase> ActionRouter;
+	};
+
+	/** Action routers by controller id, so rerouted input doesn't need to search the local players for every event */
+	TArray<FCachedActionRouter> ActionRoutersByControllerId;
+
+	/** When batching axis input, whether the UI handled each (controller, key) axis the first time it was rerouted this frame */
+	TMap<TPair<int32, FKey>, bool> AxisRerouteResults;
+	uint64 AxisRerouteResultsFrame = 0;
 };
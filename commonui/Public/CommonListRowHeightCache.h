@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Prefix-sum (Fenwick tree) of row heights, indexed by item index.
+ *
+ * Used by list views that virtualize entries of differing heights: converting between a scroll position in slate units
+ * and an item index (plus the fraction into that item) is O(log n) regardless of how many items are being observed.
+ */
+class COMMONUI_API FCommonListRowHeightCache
+{
+public:
+	/** Discards all heights and sizes the cache for NumRows rows, all of which are given the same initial height. */
+	void Reset(int32 NumRows, float InitialRowHeight);
+
+	/** Rebuilds the cache from explicit per-row heights in O(n). */
+	void Reset(TArrayView<const float> RowHeights);
+
+	/** Sets the height of a single row, O(log n) */
+	void SetRowHeight(int32 RowIndex, float NewHeight);
+
+	float GetRowHeight(int32 RowIndex) const { return RowHeights.IsValidIndex(RowIndex) ? RowHeights[RowIndex] : 0.f; }
+	int32 Num() const { return RowHeights.Num(); }
+
+	/** @return The summed height of all rows before RowIndex */
+	double GetOffsetOfRow(int32 RowIndex) const;
+
+	double GetTotalHeight() const { return GetOffsetOfRow(RowHeights.Num()); }
+
+	/** @return The index of the row that contains the given offset. Offsets past either end are clamped to the first/last row. */
+	int32 FindRowAtOffset(double Offset) const;
+
+	/** Converts a scroll offset in slate units into a list scroll offset (fractional item index) */
+	double SlateUnitsToItemOffset(double Offset) const;
+
+	/** Converts a list scroll offset (fractional item index) into a scroll offset in slate units */
+	double ItemOffsetToSlateUnits(double ItemOffset) const;
+
+private:
+	/** The raw height of each row, kept alongside the tree so individual heights can be read and updated by delta */
+	TArray<float> RowHeights;
+
+	/** 1-based Fenwick tree over RowHeights */
+	TArray<double> Tree;
+
+	/** Largest power of two <= Num(), cached for the binary descent in FindRowAtOffset */
+	int32 HighestBit = 0;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Components/ListView.h"
+#include "CommonListRowHeightCache.h"
 #include "CommonListView.generated.h"
 
 //////////////////////////////////////////////////////////////////////////
@@ -13,6 +14,80 @@ template <typename ItemType>
 class SCommonListView : public SListView<ItemType>
 {
 public:
+	/** Returns a key describing the layout of an item's entry. A measured height is only reused while the key is unchanged. */
+	typedef TDelegate<uint32(ItemType)> FOnGetItemLayoutKey;
+
+	/**
+	 * Enables virtualization of entries with differing heights (vertical lists only).
+	 * Measured entry heights are cached per item and kept in a prefix-sum, so scrolling maps slate units to items exactly
+	 * and navigating to an item lands on it regardless of how many items are being observed.
+	 */
+	void SetVariableHeightEntries(bool bEnabled, float InEstimatedEntryHeight, const FOnGetItemLayoutKey& InOnGetItemLayoutKey = FOnGetItemLayoutKey())
+	{
+		bVariableHeightEntries = bEnabled;
+		EstimatedEntryHeight = FMath::Max(InEstimatedEntryHeight, 1.f);
+		OnGetItemLayoutKey = InOnGetItemLayoutKey;
+
+		CachedRows.Reset();
+		CachedItemOrder.Reset();
+		RowHeightCache.Reset(0, EstimatedEntryHeight);
+		bRowHeightsDirty = true;
+
+		if (this->ScrollBar.IsValid())
+		{
+			// The base list maps the thumb to items, ours maps it to slate units to match the height-based thumb set in Tick
+			this->ScrollBar->SetOnUserScrolled(FOnUserScrolled::CreateSP(this, &SCommonListView::HandleScrollBarUserScrolled));
+		}
+	}
+
+	bool IsUsingVariableHeightEntries() const { return bVariableHeightEntries; }
+
+	virtual void RequestListRefresh() override
+	{
+		// Most refreshes leave the items as they were, so the cache is only rebuilt if the items turn out to differ
+		bItemsMayHaveChanged = true;
+		SListView<ItemType>::RequestListRefresh();
+	}
+
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override
+	{
+		SListView<ItemType>::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+		if (bVariableHeightEntries && this->ScrollBar.IsValid())
+		{
+			// The base list sizes the thumb from the number of rows currently on screen, which changes constantly when rows differ in height.
+			// Both the thumb and its offset are in slate units, so the thumb meets the end of the track exactly when the last row is in view.
+			const double TotalHeight = RowHeightCache.GetTotalHeight();
+			const double ViewHeight = AllottedGeometry.GetLocalSize().Y;
+			if (TotalHeight > ViewHeight)
+			{
+				const double ViewTop = RowHeightCache.ItemOffsetToSlateUnits(this->GetScrollOffset());
+				this->ScrollBar->SetState(ViewTop / TotalHeight, ViewHeight / TotalHeight);
+			}
+		}
+	}
+
+	virtual float ScrollBy(const FGeometry& MyGeometry, float ScrollByAmountInSlateUnits, EAllowOverscroll InAllowOverscroll) override
+	{
+		if (!bVariableHeightEntries || RowHeightCache.Num() == 0)
+		{
+			return SListView<ItemType>::ScrollBy(MyGeometry, ScrollByAmountInSlateUnits, InAllowOverscroll);
+		}
+
+		const double MaxOffset = FMath::Max(0., RowHeightCache.GetTotalHeight() - MyGeometry.GetLocalSize().Y);
+		const double CurrentOffset = RowHeightCache.ItemOffsetToSlateUnits(this->DesiredScrollOffset);
+		const double TargetOffset = CurrentOffset + ScrollByAmountInSlateUnits;
+		if (InAllowOverscroll == EAllowOverscroll::Yes && (TargetOffset < 0. || TargetOffset > MaxOffset))
+		{
+			// Let the base list handle the overscroll at either end
+			return SListView<ItemType>::ScrollBy(MyGeometry, ScrollByAmountInSlateUnits, InAllowOverscroll);
+		}
+
+		const double ClampedOffset = FMath::Clamp(TargetOffset, 0., MaxOffset);
+		this->ScrollTo(RowHeightCache.SlateUnitsToItemOffset(ClampedOffset));
+		return ClampedOffset - CurrentOffset;
+	}
+
 	virtual FReply OnFocusReceived(const FGeometry& MyGeometry, const FFocusEvent& InFocusEvent) override
 	{
 		if (bScrollToSelectedOnFocus && (InFocusEvent.GetCause() == EFocusCause::Navigation || InFocusEvent.GetCause() == EFocusCause::SetDirectly))
@@ -75,7 +150,207 @@ public:
 	}
 
 protected:
+	virtual STableViewBase::FReGenerateResults ReGenerateItems(const FGeometry& MyGeometry) override
+	{
+		if (!bVariableHeightEntries)
+		{
+			return SListView<ItemType>::ReGenerateItems(MyGeometry);
+		}
+
+		if (bRowHeightsDirty || !this->ItemsSource || this->ItemsSource->Num() != RowHeightCache.Num() || (bItemsMayHaveChanged && *this->ItemsSource != CachedItemOrder))
+		{
+			RebuildRowHeightCache();
+		}
+		bItemsMayHaveChanged = false;
+
+		STableViewBase::FReGenerateResults Results = SListView<ItemType>::ReGenerateItems(MyGeometry);
+		LastViewHeight = MyGeometry.GetLocalSize().Y;
+
+		if (CacheGeneratedRowHeights() && TListTypeTraits<ItemType>::IsPtrValid(PendingNavigationItem))
+		{
+			// Heights we navigated with were estimates; re-resolve against the measurements so the item lands exactly.
+			ScrollItemIntoViewExact(TListTypeTraits<ItemType>::NullableItemTypeConvertToItemType(PendingNavigationItem));
+		}
+		else
+		{
+			PendingNavigationItem = TListTypeTraits<ItemType>::MakeNullPtr();
+		}
+
+		return Results;
+	}
+
+	virtual EScrollIntoViewResult ScrollIntoView(const FGeometry& ListViewGeometry) override
+	{
+		if (bVariableHeightEntries && TListTypeTraits<ItemType>::IsPtrValid(this->ItemToScrollIntoView) && !bRowHeightsDirty && !bItemsMayHaveChanged)
+		{
+			const ItemType Item = TListTypeTraits<ItemType>::NullableItemTypeConvertToItemType(this->ItemToScrollIntoView);
+			if (CachedRows.Contains(Item))
+			{
+				LastViewHeight = ListViewGeometry.GetLocalSize().Y;
+				this->EndInertialScrolling();
+				ScrollItemIntoViewExact(Item);
+				PendingNavigationItem = this->ItemToScrollIntoView;
+
+				this->ItemToNotifyWhenInView = this->ItemToScrollIntoView;
+				this->ItemToScrollIntoView = TListTypeTraits<ItemType>::MakeNullPtr();
+				return EScrollIntoViewResult::Success;
+			}
+		}
+		return SListView<ItemType>::ScrollIntoView(ListViewGeometry);
+	}
+
 	bool bScrollToSelectedOnFocus = true;
+
+private:
+	void HandleScrollBarUserScrolled(float InScrollOffsetFraction)
+	{
+		const double TotalHeight = RowHeightCache.GetTotalHeight();
+		if (!bVariableHeightEntries || TotalHeight <= 0.)
+		{
+			this->ScrollBar_OnUserScrolled(InScrollOffsetFraction);
+			return;
+		}
+
+		const double MaxOffset = FMath::Max(0., TotalHeight - LastViewHeight);
+		const double TargetOffset = FMath::Clamp(InScrollOffsetFraction * TotalHeight, 0., MaxOffset);
+		this->ScrollTo(RowHeightCache.SlateUnitsToItemOffset(TargetOffset));
+	}
+
+	struct FCachedRow
+	{
+		int32 Index = INDEX_NONE;
+		uint32 LayoutKey = 0;
+		float Height = 0.f;
+		bool bMeasured = false;
+	};
+
+	void RebuildRowHeightCache()
+	{
+		bRowHeightsDirty = false;
+
+		TMap<ItemType, FCachedRow> PreviousRows = MoveTemp(CachedRows);
+		CachedRows.Reset();
+
+		const int32 NumItems = this->ItemsSource ? this->ItemsSource->Num() : 0;
+		if (NumItems == 0)
+		{
+			CachedItemOrder.Reset();
+			RowHeightCache.Reset(0, EstimatedEntryHeight);
+			return;
+		}
+		CachedItemOrder = *this->ItemsSource;
+
+		// Unmeasured rows are estimated from the average of everything measured so far
+		double MeasuredHeightSum = 0.;
+		int32 NumMeasured = 0;
+		for (const TPair<ItemType, FCachedRow>& PreviousRow : PreviousRows)
+		{
+			if (PreviousRow.Value.bMeasured)
+			{
+				MeasuredHeightSum += PreviousRow.Value.Height;
+				++NumMeasured;
+			}
+		}
+		const float RowEstimate = NumMeasured > 0 ? (float)(MeasuredHeightSum / NumMeasured) : EstimatedEntryHeight;
+
+		TArray<float> RowHeights;
+		RowHeights.Reserve(NumItems);
+		CachedRows.Reserve(NumItems);
+
+		for (int32 ItemIdx = 0; ItemIdx < NumItems; ++ItemIdx)
+		{
+			const ItemType& Item = (*this->ItemsSource)[ItemIdx];
+
+			FCachedRow NewRow;
+			NewRow.Index = ItemIdx;
+			NewRow.LayoutKey = OnGetItemLayoutKey.IsBound() ? OnGetItemLayoutKey.Execute(Item) : 0;
+			NewRow.Height = RowEstimate;
+
+			const FCachedRow* PreviousRow = PreviousRows.Find(Item);
+			if (PreviousRow && PreviousRow->bMeasured && PreviousRow->LayoutKey == NewRow.LayoutKey)
+			{
+				NewRow.Height = PreviousRow->Height;
+				NewRow.bMeasured = true;
+			}
+
+			CachedRows.Add(Item, NewRow);
+			RowHeights.Add(NewRow.Height);
+		}
+
+		RowHeightCache.Reset(RowHeights);
+	}
+
+	/** Records the measured height of every generated row. Returns true if any cached height changed. */
+	bool CacheGeneratedRowHeights()
+	{
+		bool bAnyHeightChanged = false;
+		for (const ItemType& Item : this->WidgetGenerator.ItemsWithGeneratedWidgets)
+		{
+			FCachedRow* CachedRow = CachedRows.Find(Item);
+			TSharedPtr<ITableRow> RowWidget = this->WidgetGenerator.GetWidgetForItem(Item);
+			if (CachedRow && RowWidget.IsValid())
+			{
+				const float MeasuredHeight = RowWidget->AsWidget()->GetDesiredSize().Y;
+
+				// The cache isn't rebuilt on every refresh, so keep the key current for the height we're about to record
+				CachedRow->LayoutKey = OnGetItemLayoutKey.IsBound() ? OnGetItemLayoutKey.Execute(Item) : 0;
+				if (!CachedRow->bMeasured || CachedRow->Height != MeasuredHeight)
+				{
+					bAnyHeightChanged |= CachedRow->Height != MeasuredHeight;
+					CachedRow->Height = MeasuredHeight;
+					CachedRow->bMeasured = true;
+					RowHeightCache.SetRowHeight(CachedRow->Index, MeasuredHeight);
+				}
+			}
+		}
+		return bAnyHeightChanged;
+	}
+
+	/** Scrolls the minimum distance needed to show the entire row of the given item */
+	void ScrollItemIntoViewExact(const ItemType& Item)
+	{
+		const FCachedRow* CachedRow = CachedRows.Find(Item);
+		if (!CachedRow)
+		{
+			return;
+		}
+
+		const double RowTop = RowHeightCache.GetOffsetOfRow(CachedRow->Index);
+		const double RowBottom = RowTop + RowHeightCache.GetRowHeight(CachedRow->Index);
+		const double ViewTop = RowHeightCache.ItemOffsetToSlateUnits(this->DesiredScrollOffset);
+
+		double NewViewTop = ViewTop;
+		if (RowTop < ViewTop || RowBottom - RowTop > LastViewHeight)
+		{
+			NewViewTop = RowTop;
+		}
+		else if (RowBottom > ViewTop + LastViewHeight)
+		{
+			NewViewTop = RowBottom - LastViewHeight;
+		}
+
+		if (NewViewTop != ViewTop)
+		{
+			this->SetScrollOffset(RowHeightCache.SlateUnitsToItemOffset(NewViewTop));
+			this->RequestLayoutRefresh();
+		}
+	}
+
+	bool bVariableHeightEntries = false;
+	bool bRowHeightsDirty = true;
+	bool bItemsMayHaveChanged = false;
+	float EstimatedEntryHeight = 64.f;
+	float LastViewHeight = 0.f;
+
+	FOnGetItemLayoutKey OnGetItemLayoutKey;
+	TMap<ItemType, FCachedRow> CachedRows;
+
+	/** The items as of the last rebuild, compared against on refresh to tell whether the cache needs rebuilding at all */
+	TArray<ItemType> CachedItemOrder;
+	FCommonListRowHeightCache RowHeightCache;
+
+	/** Item most recently navigated to, re-resolved while its neighbors' heights are still being measured */
+	typename TListTypeTraits<ItemType>::NullableType PendingNavigationItem = TListTypeTraits<ItemType>::MakeNullPtr();
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -93,6 +368,41 @@ public:
 	UFUNCTION(BlueprintCallable, Category = ListView)
 	void SetEntrySpacing(float InEntrySpacing);
 
+	/** Returns a key identifying the layout of the given item's entry. Cached entry heights are discarded when an item's key changes. */
+	DECLARE_DELEGATE_RetVal_OneParam(uint32, FOnGetEntryLayoutKey, UObject*);
+	FOnGetEntryLayoutKey& OnGetEntryLayoutKey() { return OnGetEntryLayoutKeyDelegate; }
+
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+	/**
+	 * Replaces the list items with the given array, keyed by item identity.
+	 * Unlike SetListItems, only entries for items that were not previously in the list are generated, and selection and scroll position are preserved.
+	 */
+	UFUNCTION(BlueprintCallable, Category = ListView)
+	void UpdateListItems(const TArray<UObject*>& NewListItems);
+
+	/** As UpdateListItems, for callers that already know which items were added and removed (e.g. TCommonAsyncListSource) */
+	void UpdateListItemsWithDiff(const TArray<UObject*>& NewListItems, const TArray<UObject*>& AddedItems, const TArray<UObject*>& RemovedItems);
+
+	/** Inserts the given items at Index without regenerating the entries of existing items */
+	UFUNCTION(BlueprintCallable, Category = ListView)
+	void InsertItemsAt(int32 Index, const TArray<UObject*>& ItemsToInsert);
+
+	/** Removes Count items starting at Index without regenerating the entries of the remaining items */
+	UFUNCTION(BlueprintCallable, Category = ListView)
+	void RemoveItemsAt(int32 Index, int32 Count = 1);
+
+	/** Moves the item at FromIndex so that it ends up at ToIndex. Its entry is kept. */
+	UFUNCTION(BlueprintCallable, Category = ListView)
+	void MoveItem(int32 FromIndex, int32 ToIndex);
+
+	/** Replaces the item at Index with NewItem. Only the entry for that index is regenerated. */
+	UFUNCTION(BlueprintCallable, Category = ListView)
+	void ReplaceItemAt(int32 Index, UObject* NewItem);
+
+	/** @return The number of entries generated since the last incremental update was applied */
+	int32 GetNumEntriesGeneratedSinceLastUpdate() const { return NumEntriesGeneratedSinceLastUpdate; }
+
 #if WITH_EDITOR
 	virtual const FText GetPaletteCategory() override;
 #endif
@@ -100,4 +410,34 @@ public:
 protected:
 	virtual TSharedRef<STableViewBase> RebuildListWidget() override;
 	virtual UUserWidget& OnGenerateEntryWidgetInternal(UObject* Item, TSubclassOf<UUserWidget> DesiredEntryClass, const TSharedRef<STableViewBase>& OwnerTable) override;
+
+	/**
+	 * Cache the measured height of each entry so that lists of entries with differing heights scroll smoothly and navigate exactly.
+	 * Use OnGetEntryLayoutKey to invalidate the cached height of items whose entry layout changes.
+	 */
+	UPROPERTY(EditAnywhere, Category = ListEntries)
+	bool bEnableVariableHeightEntries = false;
+
+	/** Height assumed for entries that have not been generated yet, until enough entries have been measured to average */
+	UPROPERTY(EditAnywhere, Category = ListEntries, meta = (EditCondition = "bEnableVariableHeightEntries", ClampMin = 1))
+	float EstimatedEntryHeight = 64.f;
+
+	TSharedPtr<SCommonListView<UObject*>> MyCommonListView;
+
+private:
+	uint32 GetEntryLayoutKey(UObject* Item) const;
+
+	/** The first visible item and how far into it the list is scrolled, used to keep the view still while items around it change */
+	struct FScrollAnchor
+	{
+		UObject* Item = nullptr;
+		float Fraction = 0.f;
+	};
+
+	FScrollAnchor CaptureScrollAnchor() const;
+	void FinishIncrementalUpdate(const TArray<UObject*>& AddedItems, const TArray<UObject*>& RemovedItems, const FScrollAnchor& ScrollAnchor);
+
+	FOnGetEntryLayoutKey OnGetEntryLayoutKeyDelegate;
+
+	int32 NumEntriesGeneratedSinceLastUpdate = 0;
 };
\ No newline at end of file
@@ -3,6 +3,49 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+
+/**
+ * Identifies a native list item type by its depth in the DERIVED_LIST_ITEM hierarchy and the type names of each of its ancestors.
+ * Determining whether an item derives from a given type is a single name comparison at that type's depth.
+ *
+ * Every module that uses an item type gets its own copy of the type's info, so types are told apart by name rather than by
+ * the address of their info. Item type names must therefore be unique among the types deriving from the same parent.
+ */
+struct FCommonNativeListItemTypeInfo
+{
+	static constexpr int32 MaxDepth = 16;
+
+	/** Constructs the info for the root item type */
+	explicit FCommonNativeListItemTypeInfo(FName TypeName)
+		: Depth(0)
+	{
+		Ancestors[0] = TypeName;
+	}
+
+	/** Constructs the info for a type deriving from ParentTypeInfo */
+	FCommonNativeListItemTypeInfo(FName TypeName, const FCommonNativeListItemTypeInfo& ParentTypeInfo)
+		: Depth(ParentTypeInfo.Depth + 1)
+	{
+		check(Depth < MaxDepth);
+		for (int32 AncestorDepth = 0; AncestorDepth < Depth; ++AncestorDepth)
+		{
+			Ancestors[AncestorDepth] = ParentTypeInfo.Ancestors[AncestorDepth];
+		}
+		Ancestors[Depth] = TypeName;
+	}
+
+	FCommonNativeListItemTypeInfo(const FCommonNativeListItemTypeInfo&) = delete;
+	FCommonNativeListItemTypeInfo& operator=(const FCommonNativeListItemTypeInfo&) = delete;
+
+	FORCEINLINE bool IsA(const FCommonNativeListItemTypeInfo& OtherTypeInfo) const
+	{
+		return OtherTypeInfo.Depth <= Depth && Ancestors[OtherTypeInfo.Depth] == OtherTypeInfo.Ancestors[OtherTypeInfo.Depth];
+	}
+
+	const int32 Depth;
+	FName Ancestors[MaxDepth];
+};
 
 /** 
  * Base item class for any UMG ListViews based on native, non-UObject items.
@@ -13,13 +56,17 @@
 class FCommonNativeListItem : public TSharedFromThis<FCommonNativeListItem>
 {
 public:
+	FCommonNativeListItem() {}
+	FCommonNativeListItem(const FCommonNativeListItem& Other) : TSharedFromThis<FCommonNativeListItem>(Other) {}
+	FCommonNativeListItem& operator=(const FCommonNativeListItem&) { return *this; }
 	virtual ~FCommonNativeListItem() {}
 	
 	template <typename ListItemT>
 	bool IsDerivedFrom() const
 	{
 		static_assert(TIsDerivedFrom<ListItemT, FCommonNativeListItem>::IsDerived, "FCommonNativeListItem::AsTypedItem<T> only supports FCommonNativeListItem types");
-		return IsDerivedInternal(ListItemT::StaticItemType());
+		static_assert(ListItemT::ItemTypeDepth < FCommonNativeListItemTypeInfo::MaxDepth, "DERIVED_LIST_ITEM hierarchy is too deep, increase FCommonNativeListItemTypeInfo::MaxDepth");
+		return GetItemTypeInfo().IsA(ListItemT::StaticItemTypeInfo());
 	}
 
 	template <typename ListItemT>
@@ -34,9 +81,33 @@ public:
 		return TSharedPtr<ListItemT>();
 	}
 
+	/** The type info of the most derived type of this item */
+	const FCommonNativeListItemTypeInfo& GetItemTypeInfo() const
+	{
+		// The type can't be resolved during construction, so it's looked up on first use and cached from then on
+		const FCommonNativeListItemTypeInfo* TypeInfo = CachedItemTypeInfo.Load(EMemoryOrder::Relaxed);
+		if (!TypeInfo)
+		{
+			TypeInfo = &GetItemTypeInfoInternal();
+			CachedItemTypeInfo.Store(TypeInfo, EMemoryOrder::Relaxed);
+		}
+		return *TypeInfo;
+	}
+
+	static constexpr int32 ItemTypeDepth = 0;
+
+	static const FCommonNativeListItemTypeInfo& StaticItemTypeInfo()
+	{
+		static const FCommonNativeListItemTypeInfo TypeInfo(StaticItemType());
+		return TypeInfo;
+	}
+
 protected:
 	static FName StaticItemType() { return TEXT("CommonNativeListItem"); }
-	virtual bool IsDerivedInternal(FName ItemTypeName) const { return ItemTypeName == StaticItemType(); }
+	virtual const FCommonNativeListItemTypeInfo& GetItemTypeInfoInternal() const { return StaticItemTypeInfo(); }
+
+private:
+	mutable TAtomic<const FCommonNativeListItemTypeInfo*> CachedItemTypeInfo{ nullptr };
 };
 
 /**
@@ -44,9 +115,15 @@ protected:
  */
 #define DERIVED_LIST_ITEM(ItemType, ParentItemType)	\
 protected:	\
-	virtual bool IsDerivedInternal(FName ItemTypeName) const override { return StaticItemType() == ItemTypeName || ParentItemType::IsDerivedInternal(ItemTypeName); }	\
+	virtual const FCommonNativeListItemTypeInfo& GetItemTypeInfoInternal() const override { return StaticItemTypeInfo(); }	\
 public:	\
 	static FName StaticItemType() { return FName(#ItemType); }	\
+	static constexpr int32 ItemTypeDepth = ParentItemType::ItemTypeDepth + 1;	\
+	static const FCommonNativeListItemTypeInfo& StaticItemTypeInfo()	\
+	{	\
+		static const FCommonNativeListItemTypeInfo TypeInfo(StaticItemType(), ParentItemType::StaticItemTypeInfo());	\
+		return TypeInfo;	\
+	}	\
 private: //
 
 /*
@@ -121,6 +121,7 @@ public:
 		, FontAlpha(1.f)
 	{
 	}
+	virtual ~STextScroller();
 
 	void Construct(const FArguments& InArgs);
 
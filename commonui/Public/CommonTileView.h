@@ -5,6 +5,10 @@
 #include "Components/TileView.h"
 #include "CommonTileView.generated.h"
 
+template <typename ItemType> class SCommonTileView;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTileGenerationComplete, UCommonTileView*, TileView);
+
 UCLASS(meta = (DisableNativeTick))
 class COMMONUI_API UCommonTileView : public UTileView
 {
@@ -13,7 +17,69 @@ class COMMONUI_API UCommonTileView : public UTileView
 public:
 	UCommonTileView(const FObjectInitializer& ObjectInitializer);
 
+	/**
+	 * Replaces the list items with the given array, keyed by item identity.
+	 * Unlike SetListItems, only entries for items that were not previously in the list are generated, and the selection is preserved.
+	 */
+	UFUNCTION(BlueprintCallable, Category = TileView)
+	void UpdateListItems(const TArray<UObject*>& NewListItems);
+
+	/** As UpdateListItems, for callers that already know which items were added and removed (e.g. TCommonAsyncListSource) */
+	void UpdateListItemsWithDiff(const TArray<UObject*>& NewListItems, const TArray<UObject*>& AddedItems, const TArray<UObject*>& RemovedItems);
+
+	/** @return True while placeholder tiles are still waiting to be replaced by their entries */
+	UFUNCTION(BlueprintCallable, Category = TileView)
+	bool IsProgressiveGenerationPending() const { return ProgressiveGenerationTickerHandle.IsValid(); }
+
+	/** Broadcast once every placeholder tile has been replaced by its entry */
+	UPROPERTY(BlueprintAssignable, Category = TileView)
+	FOnTileGenerationComplete OnProgressiveGenerationComplete;
+
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
 protected:
 	virtual TSharedRef<STableViewBase> RebuildListWidget() override;
 	virtual UUserWidget& OnGenerateEntryWidgetInternal(UObject* Item, TSubclassOf<UUserWidget> DesiredEntryClass, const TSharedRef<STableViewBase>& OwnerTable) override;
+
+	/**
+	 * Spread the generation of entries over several frames. Tiles that don't fit in the per-frame budget show a placeholder entry
+	 * and are generated on later frames, nearest to the selected (or first visible) tile first.
+	 */
+	UPROPERTY(EditAnywhere, Category = TileView)
+	bool bEnableProgressiveGeneration = false;
+
+	/** Lightweight entry shown in place of tiles that haven't been generated yet */
+	UPROPERTY(EditAnywhere, Category = TileView, meta = (EditCondition = "bEnableProgressiveGeneration", MustImplement = UserListEntry))
+	TSubclassOf<UUserWidget> PlaceholderEntryClass;
+
+	/** Time that may be spent generating tiles each frame, in milliseconds */
+	UPROPERTY(EditAnywhere, Category = TileView, meta = (EditCondition = "bEnableProgressiveGeneration", ClampMin = 0.1))
+	float GenerationBudgetMs = 2.f;
+
+	TSharedPtr<SCommonTileView<UObject*>> MyCommonTileView;
+
+private:
+	UUserWidget& GenerateEntry(TSubclassOf<UUserWidget> DesiredEntryClass, const TSharedRef<STableViewBase>& OwnerTable);
+	bool ShouldGeneratePlaceholder(UObject* Item, int32 ItemIndex);
+	bool TickProgressiveGeneration(float DeltaTime);
+
+	int32 FindItemIndex(UObject* Item);
+	int32 GetNumItemsPerLine() const;
+	int32 GetGenerationAnchorIndex() const;
+	int32 GetTileDistance(int32 ItemIndexA, int32 ItemIndexB, int32 NumItemsPerLine) const;
+
+	/** Items currently showing placeholders, with their index in ListItems when the placeholder was generated */
+	TMap<TWeakObjectPtr<UObject>, int32> PendingItems;
+
+	/** Items whose rows were discarded this frame so their entries can be generated */
+	TSet<UObject*> ItemsBeingGenerated;
+
+	FDelegateHandle ProgressiveGenerationTickerHandle;
+
+	uint64 BudgetFrameNumber = 0;
+	double BudgetSpentThisFrame = 0.;
+	double AverageEntryGenerationTime = 0.;
+	int32 BudgetAnchorIndex = 0;
+	int32 BudgetRadius = 0;
+	int32 LastFoundItemIndex = 0;
 };
\ No newline at end of file
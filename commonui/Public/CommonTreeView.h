@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Components/TreeView.h"
+#include "CommonFlattenedTree.h"
 #include "CommonTreeView.generated.h"
 
 //////////////////////////////////////////////////////////////////////////
@@ -13,6 +14,112 @@ template <typename ItemType>
 class SCommonTreeView : public STreeView<ItemType>
 {
 public:
+	/**
+	 * Switches the tree over to a TCommonFlattenedTree: children are requested once per node and cached, and expanding or collapsing
+	 * an item splices only its subtree in or out, instead of the whole tree being relinearized.
+	 * Refreshing the tree re-reads the root items but keeps cached children; use InvalidateItemChildren when an item's children change.
+	 */
+	void EnableFlattenedTree(const typename TCommonFlattenedTree<ItemType>::FOnRequestChildrenAsync& InOnRequestChildrenAsync)
+	{
+		FlattenedTree = MakeUnique<TCommonFlattenedTree<ItemType>>();
+		FlattenedTree->OnGetChildren = this->OnGetChildren;
+		FlattenedTree->OnRequestChildrenAsync = InOnRequestChildrenAsync;
+
+		// The list reads the flattened items directly, bypassing the tree's own linearization
+		this->ItemsSource = &FlattenedTree->GetLinearizedItems();
+		this->RequestTreeRefresh();
+	}
+
+	bool IsUsingFlattenedTree() const { return FlattenedTree.IsValid(); }
+
+	/** Adds children to an item whose children are being provided asynchronously (see EnableFlattenedTree) */
+	void AppendItemChildren(const ItemType& ParentItem, TArrayView<const ItemType> NewChildren, bool bIsFinalBatch)
+	{
+		if (FlattenedTree && FlattenedTree->AppendChildren(ParentItem, NewChildren, bIsFinalBatch))
+		{
+			SListView<ItemType>::RequestListRefresh();
+		}
+	}
+
+	/** Discards the cached children of an item so they are requested again */
+	void InvalidateItemChildren(const ItemType& Item)
+	{
+		if (FlattenedTree && FlattenedTree->InvalidateChildren(Item))
+		{
+			SListView<ItemType>::RequestListRefresh();
+		}
+	}
+
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override
+	{
+		if (FlattenedTree && this->bTreeItemsAreDirty)
+		{
+			this->bTreeItemsAreDirty = false;
+			if (this->TreeItemsSource)
+			{
+				FlattenedTree->SetRootItems(*this->TreeItemsSource);
+			}
+			this->ItemsSource = &FlattenedTree->GetLinearizedItems();
+			SListView<ItemType>::RequestListRefresh();
+		}
+
+		STreeView<ItemType>::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+	}
+
+	virtual bool Private_IsItemExpanded(const ItemType& TheItem) const override
+	{
+		return FlattenedTree ? FlattenedTree->IsItemExpanded(TheItem) : STreeView<ItemType>::Private_IsItemExpanded(TheItem);
+	}
+
+	virtual void Private_SetItemExpansion(ItemType TheItem, bool bShouldBeExpanded) override
+	{
+		if (!FlattenedTree)
+		{
+			STreeView<ItemType>::Private_SetItemExpansion(TheItem, bShouldBeExpanded);
+		}
+		else if (FlattenedTree->IsItemExpanded(TheItem) != bShouldBeExpanded)
+		{
+			if (FlattenedTree->SetItemExpansion(TheItem, bShouldBeExpanded))
+			{
+				SListView<ItemType>::RequestListRefresh();
+			}
+			this->OnExpansionChanged.ExecuteIfBound(TheItem, bShouldBeExpanded);
+		}
+	}
+
+	virtual void Private_OnExpanderArrowShiftClicked(ItemType TheItem, bool bShouldBeExpanded) override
+	{
+		if (FlattenedTree)
+		{
+			// Recursive expansion would defeat the point of populating subtrees on demand
+			Private_SetItemExpansion(TheItem, bShouldBeExpanded);
+		}
+		else
+		{
+			STreeView<ItemType>::Private_OnExpanderArrowShiftClicked(TheItem, bShouldBeExpanded);
+		}
+	}
+
+	virtual bool Private_DoesItemHaveChildren(int32 ItemIndexInList) const override
+	{
+		if (FlattenedTree)
+		{
+			const TArray<ItemType>& LinearizedItems = FlattenedTree->GetLinearizedItems();
+			return LinearizedItems.IsValidIndex(ItemIndexInList) && FlattenedTree->DoesItemHaveChildren(LinearizedItems[ItemIndexInList]);
+		}
+		return STreeView<ItemType>::Private_DoesItemHaveChildren(ItemIndexInList);
+	}
+
+	virtual int32 Private_GetNestingDepth(int32 ItemIndexInList) const override
+	{
+		return FlattenedTree ? FlattenedTree->GetNestingDepth(ItemIndexInList) : STreeView<ItemType>::Private_GetNestingDepth(ItemIndexInList);
+	}
+
+	virtual const TBitArray<>& Private_GetWiresNeededByDepth(int32 ItemIndexInList) const override
+	{
+		return FlattenedTree ? FlattenedTree->GetWiresNeededByDepth(ItemIndexInList) : STreeView<ItemType>::Private_GetWiresNeededByDepth(ItemIndexInList);
+	}
+
 	virtual FReply OnFocusReceived(const FGeometry& MyGeometry, const FFocusEvent& InFocusEvent) override
 	{
 		if (bScrollToSelectedOnFocus && (InFocusEvent.GetCause() == EFocusCause::Navigation || InFocusEvent.GetCause() == EFocusCause::SetDirectly))
@@ -75,6 +182,9 @@ public:
 
 protected:
 	bool bScrollToSelectedOnFocus = true;
+
+private:
+	TUniquePtr<TCommonFlattenedTree<ItemType>> FlattenedTree;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -89,7 +199,38 @@ class COMMONUI_API UCommonTreeView : public UTreeView
 public:
 	UCommonTreeView(const FObjectInitializer& ObjectInitializer);
 
+	/**
+	 * Return true to take over populating the item's children, which are then provided over as many frames as needed with AppendItemChildren.
+	 * Only used when bUseFlattenedTree is set, and must be bound before the underlying widget is built.
+	 */
+	DECLARE_DELEGATE_RetVal_OneParam(bool, FOnRequestItemChildrenAsync, UObject*);
+	FOnRequestItemChildrenAsync& OnRequestItemChildrenAsync() { return OnRequestItemChildrenAsyncDelegate; }
+
+	/** Provides children for an item whose children were requested through OnRequestItemChildrenAsync */
+	UFUNCTION(BlueprintCallable, Category = TreeView)
+	void AppendItemChildren(UObject* Item, const TArray<UObject*>& Children, bool bIsFinalBatch);
+
+	/** Discards the cached children of an item so they are requested again. Only relevant when bUseFlattenedTree is set. */
+	UFUNCTION(BlueprintCallable, Category = TreeView)
+	void InvalidateItemChildren(UObject* Item);
+
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
 protected:
 	virtual TSharedRef<STableViewBase> RebuildListWidget() override;
 	virtual UUserWidget& OnGenerateEntryWidgetInternal(UObject* Item, TSubclassOf<UUserWidget> DesiredEntryClass, const TSharedRef<STableViewBase>& OwnerTable) override;
+
+	/**
+	 * Cache the children and depth of each item so that expanding or collapsing an item only updates its own subtree.
+	 * Children are requested once; refreshing the list re-reads the root items only.
+	 */
+	UPROPERTY(EditAnywhere, Category = TreeView)
+	bool bUseFlattenedTree = false;
+
+	TSharedPtr<SCommonTreeView<UObject*>> MyCommonTreeView;
+
+private:
+	bool HandleRequestItemChildrenAsync(UObject* Item);
+
+	FOnRequestItemChildrenAsync OnRequestItemChildrenAsyncDelegate;
 };
\ No newline at end of file
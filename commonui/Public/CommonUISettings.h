@@ -36,6 +36,7 @@ public:
 	UCommonUIRichTextData* GetRichTextData() const;
 	const FSlateBrush& GetDefaultThrobberBrush() const;
 	UObject* GetDefaultImageResourceObject() const;
+	int32 GetMaxConcurrentVideoDecoders() const { return MaxConcurrentVideoDecoders; }
 
 private:
 
@@ -57,6 +58,13 @@ private:
 	UPROPERTY(config, EditAnywhere, Category = "RichText")
 	TSoftClassPtr<UCommonUIRichTextData> DefaultRichTextDataClass;
 
+	/**
+	 * The most CommonVideoPlayers that can hold a media player (and so a decoder) at once, per game instance.
+	 * Video players asking for one beyond this wait until another releases theirs. 0 means no limit.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Video", meta = (ClampMin = "0"))
+	int32 MaxConcurrentVideoDecoders;
+
 private:
 	void LoadEditorData();
 
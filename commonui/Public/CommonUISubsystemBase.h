@@ -5,6 +5,7 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Engine/DataTable.h"
 #include "Styling/SlateBrush.h"
+#include "CommonVideoPlayer.h"
 
 #include "CommonUISubsystemBase.generated.h"
 
@@ -22,6 +23,7 @@ public:
 
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
 
 	/** set the analytic provider for the CommonUI Widgets to use */
 	void SetAnalyticProvider(const TSharedPtr<IAnalyticsProviderET>& AnalyticProvider);
@@ -43,6 +45,31 @@ public:
 public:
 	virtual void SetInputAllowed(bool bEnabled, const FName& Reason, const ULocalPlayer& LocalPlayer);
 
+public:
+	/**
+	 * Hands a set of pooled video resources to the given owner, unless MaxConcurrentVideoDecoders sets are already in use.
+	 * In that case the request is queued, and OnResourcesAvailable fires once a set has been released and the owner can try again.
+	 */
+	bool AcquireVideoResources(const UObject& Owner, FCommonVideoPlayerResources& OutResources, const FSimpleDelegate& OnResourcesAvailable);
+	void ReleaseVideoResources(const UObject& Owner);
+	void CancelVideoResourcesRequest(const UObject& Owner);
+
+	int32 GetNumVideoResourcesInUse() const { return VideoResourcesInUse.Num(); }
+
+private:
+	/** Returns resources whose owners were destroyed without releasing them to the pool */
+	void ReclaimOrphanedVideoResources();
+	void ResetVideoResources(FCommonVideoPlayerResources& Resources);
+	void ServeVideoResourcesRequests();
+
+	UPROPERTY(Transient)
+	TArray<FCommonVideoPlayerResources> IdleVideoResources;
+
+	UPROPERTY(Transient)
+	TArray<FCommonVideoPlayerResources> VideoResourcesInUse;
+
+	TArray<TPair<TWeakObjectPtr<const UObject>, FSimpleDelegate>> VideoResourcesRequests;
+
 private:
 
 	void HandleInputMethodChanged(ECommonInputType bNewInputType);
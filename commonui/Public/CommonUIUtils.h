@@ -66,6 +66,33 @@ namespace CommonUIUtils
 	 */
 	FString PrintAllOwningUserWidgets(const UWidget* Widget);
 
+	/**
+	 * Collects the items that are only in NewItems and the items that are only in PreviousItems, keyed by item identity.
+	 * Order within each array follows the array the items came from.
+	 */
+	template <typename ItemType>
+	void DiffListItems(const TArray<ItemType>& PreviousItems, const TArray<ItemType>& NewItems, TArray<ItemType>& OutAddedItems, TArray<ItemType>& OutRemovedItems)
+	{
+		const TSet<ItemType> PreviousItemSet(PreviousItems);
+		const TSet<ItemType> NewItemSet(NewItems);
+
+		for (const ItemType& NewItem : NewItems)
+		{
+			if (!PreviousItemSet.Contains(NewItem))
+			{
+				OutAddedItems.Add(NewItem);
+			}
+		}
+
+		for (const ItemType& PreviousItem : PreviousItems)
+		{
+			if (!NewItemSet.Contains(PreviousItem))
+			{
+				OutRemovedItems.Add(PreviousItem);
+			}
+		}
+	}
+
 #if WITH_EDITOR
 	/**
 	 * Validates that a given widget tree hierarchy satisfies the condition that a given widget contains N other widgets (optionally requiring individual slots for each)
@@ -28,6 +28,10 @@ public:
 	const TArray<FUIActionBindingHandle>& GetActionBindings() const { return ActionBindings; }
 	const TArray<TWeakObjectPtr<const UWidget>> GetScrollRecipients() const { return ScrollRecipients; }
 
+	DECLARE_MULTICAST_DELEGATE_OneParam(FScrollRecipientsChangedEvent, UCommonUserWidget&);
+	/** Fires when a constructed widget registers or unregisters a scroll recipient, or a widget with scroll recipients is constructed or destructed */
+	static FScrollRecipientsChangedEvent OnScrollRecipientsChanged;
+
 protected:
 	virtual void OnWidgetRebuilt() override;
 	virtual void NativeDestruct() override;
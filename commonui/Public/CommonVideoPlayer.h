@@ -6,16 +6,50 @@
 
 #include "CommonVideoPlayer.generated.h"
 
-class SImage;
+class SCommonVideoImage;
 class UMaterial;
 class UMediaSource;
 class UMediaPlayer;
 class UMediaTexture;
 class UMediaSoundComponent;
 class USoundClass;
+class UMaterialInstanceDynamic;
+class UCommonUISubsystemBase;
 
 enum class EMediaEvent;
 
+/** The media objects a video player needs to decode and play a video, pooled by UCommonUISubsystemBase */
+USTRUCT()
+struct COMMONUI_API FCommonVideoPlayerResources
+{
+	GENERATED_BODY()
+
+	/** Creates a set of resources that can be used by any video player */
+	static FCommonVideoPlayerResources Create(UObject& Outer);
+
+	UPROPERTY(Transient)
+	UMediaPlayer* MediaPlayer = nullptr;
+
+	UPROPERTY(Transient)
+	UMediaTexture* MediaTexture = nullptr;
+
+	UPROPERTY(Transient)
+	UMediaSoundComponent* SoundComponent = nullptr;
+
+	/** The video player using these resources, if any */
+	TWeakObjectPtr<const UObject> Owner;
+};
+
+/**
+ * Plays a video into an image.
+ *
+ * The media player, texture and sound component are only acquired the first time a video is set or played, and come from
+ * a pool shared by the game instance that limits how many are decoding at once. They're returned to the pool when the
+ * player is closed or leaves the screen, so video players that never play cost next to nothing.
+ *
+ * Playback is also suspended while the player isn't being drawn (ex: it's on a hidden switcher page or in a deactivated
+ * menu), and picks back up from the same point once it's drawn again. Suspension is invisible to users of the player.
+ */
 UCLASS()
 class COMMONUI_API UCommonVideoPlayer : public UWidget
 {
@@ -23,7 +57,6 @@ class COMMONUI_API UCommonVideoPlayer : public UWidget
 
 public:
 	UCommonVideoPlayer(const FObjectInitializer& Initializer);
-	virtual void PostInitProperties() override;
 
 	void SetVideo(UMediaSource* NewVideo);
 	void Seek(float PlaybackTime);
@@ -57,6 +90,9 @@ protected:
 	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
 
 	void PlayInternal() const;
+
+	/** Whether the media player (and everything else needed to play) is currently held. Until it is, GetMediaPlayer is invalid. */
+	bool HasMediaResources() const { return MediaPlayer != nullptr; }
 	const UMediaPlayer& GetMediaPlayer() const { return *MediaPlayer; }
 	virtual void HandleMediaPlayerEvent(EMediaEvent EventType);
 	virtual void PlaybackTick(double InCurrentTime, float InDeltaTime);
@@ -64,10 +100,30 @@ protected:
 private:
 	EActiveTimerReturnType HandlePlaybackTick(double InCurrentTime, float InDeltaTime);
 
+	/** @return True if the media resources are held, false if they aren't available yet (in which case they've been requested) */
+	bool AcquireMediaResources();
+	void ReleaseMediaResources();
+	void HandleMediaResourcesAvailable();
+
+	void OpenVideo();
+	void ApplyPendingPlayback();
+
+	bool HandleSuspensionTick(float DeltaTime);
+	void SuspendPlayback();
+	void ResumeSuspendedPlayback();
+	void StopSuspensionChecks();
+
 private:
 	UPROPERTY(EditAnywhere, Category = VideoPlayer)
 	UMediaSource* Video;
 
+	UPROPERTY(EditAnywhere, Category = VideoPlayer, meta = (InlineEditConditionToggle))
+	bool bSuspendWhenNotDrawn = true;
+
+	/** Once the player has gone this many frames without being drawn, decoding is paused until it's drawn again */
+	UPROPERTY(EditAnywhere, Category = VideoPlayer, meta = (EditCondition = "bSuspendWhenNotDrawn", ClampMin = 1))
+	int32 SuspendAfterUndrawnFrames = 2;
+
 	UPROPERTY(Transient)
 	UMediaPlayer* MediaPlayer;
 
@@ -77,6 +133,9 @@ private:
 	UPROPERTY(Transient)
 	UMaterial* VideoMaterial;
 
+	UPROPERTY(Transient)
+	UMaterialInstanceDynamic* VideoMID;
+
 	UPROPERTY(Transient)
 	UMediaSoundComponent* SoundComponent;
 
@@ -89,5 +148,18 @@ private:
 
 
 	bool bIsMuted = false;
-	TSharedPtr<SImage> MyImage;
+	bool bIsLooping = false;
+
+	/** Playback requested before the video was ready to play, applied once it is */
+	float PendingPlaybackRate = 0.f;
+	TOptional<float> PendingSeekTime;
+
+	/** The subsystem the media resources came from. Null if they were created just for us (i.e. outside of a game). */
+	TWeakObjectPtr<UCommonUISubsystemBase> MediaResourcesPool;
+
+	/** The rate we were playing at before being suspended for not being drawn, if we are */
+	TOptional<float> SuspendedPlaybackRate;
+	FDelegateHandle SuspensionTickerHandle;
+
+	TSharedPtr<SCommonVideoImage> MyImage;
 };
@@ -43,12 +43,16 @@ public:
 	UWidget* GetWidgetAtIndex(int32 Index) const;
 
 	virtual void SynchronizeProperties() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
 
 	void MoveChild(int32 CurrentIdx, int32 NewIdx);
 
 	DECLARE_MULTICAST_DELEGATE_OneParam(FOnActiveWidgetIndexChanged, int32)
 	FOnActiveWidgetIndexChanged& OnActiveWidgetIndexChanged() const { return OnActiveWidgetIndexChangedEvent; }
 
+	/** @return The number of slots whose content currently has its Slate resources built */
+	int32 GetNumResidentSlots() const;
+
 #if WITH_EDITOR
 public:
 
@@ -79,6 +83,10 @@ protected:
 	virtual void SetActiveWidgetIndex_Internal(int32 Index, bool bBroadcastChange = true);
 	void ResetSlotVisibilities();
 
+	/** Unloads any inactive slots beyond the resident limit or past the unload delay, as configured. Returns true if more are due to be unloaded later. */
+	bool UnloadIdleSlots();
+	bool HandleUnloadIdleSlotsTick(float DeltaTime);
+
 	UPROPERTY(EditAnywhere, Category = CommonVisibilitySwitcher)
 	ESlateVisibility ShownVisibility = ESlateVisibility::SelfHitTestInvisible;
 
@@ -93,5 +101,19 @@ protected:
 	UPROPERTY(EditAnywhere, Category = CommonVisibilitySwitcher)
 	bool bActivateFirstSlotOnAdding = false;
 
+	/**
+	 * If above 0, slots that have been inactive for this many seconds release the Slate resources of their content, which is rebuilt when the slot is next activated.
+	 * Content implementing CommonPoolableWidgetInterface is told when it's released and reacquired.
+	 */
+	UPROPERTY(EditAnywhere, Category = CommonVisibilitySwitcher, meta = (ClampMin = 0))
+	float InactiveSlotUnloadDelay = 0.f;
+
+	/** If above 0, only this many of the most recently active inactive slots are kept built, the rest release their Slate resources as above. */
+	UPROPERTY(EditAnywhere, Category = CommonVisibilitySwitcher, meta = (ClampMin = 0))
+	int32 MaxResidentInactiveSlots = 0;
+
 	mutable FOnActiveWidgetIndexChanged OnActiveWidgetIndexChangedEvent;
+
+private:
+	FDelegateHandle UnloadIdleSlotsTickerHandle;
 };
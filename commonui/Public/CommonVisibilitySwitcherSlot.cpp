@@ -2,6 +2,7 @@
 
 #include "CommonVisibilitySwitcherSlot.h"
 
+#include "CommonPoolableWidgetInterface.h"
 #include "Components/Widget.h"
 #include "Widgets/Layout/SBox.h"
 
@@ -31,6 +32,38 @@ void UCommonVisibilitySwitcherSlot::ReleaseSlateResources(bool bReleaseChildren)
 	Super::ReleaseSlateResources(bReleaseChildren);
 
 	VisibilityBox.Reset();
+	bIsContentUnloaded = false;
+}
+
+void UCommonVisibilitySwitcherSlot::UnloadContent()
+{
+	if (VisibilityBox.IsValid() && Content && !bIsContentUnloaded)
+	{
+		bIsContentUnloaded = true;
+		VisibilityBox->SetContent(SNullWidget::NullWidget);
+
+		if (Content->Implements<UCommonPoolableWidgetInterface>())
+		{
+			ICommonPoolableWidgetInterface::Execute_OnReleaseToPool(Content);
+		}
+		Content->ReleaseSlateResources(true);
+	}
+}
+
+void UCommonVisibilitySwitcherSlot::ReloadContent()
+{
+	if (VisibilityBox.IsValid() && bIsContentUnloaded)
+	{
+		bIsContentUnloaded = false;
+		if (Content)
+		{
+			if (Content->Implements<UCommonPoolableWidgetInterface>())
+			{
+				ICommonPoolableWidgetInterface::Execute_OnAcquireFromPool(Content);
+			}
+			VisibilityBox->SetContent(Content->TakeWidget());
+		}
+	}
 }
 
 void UCommonVisibilitySwitcherSlot::SetSlotVisibility(ESlateVisibility Visibility)
@@ -26,7 +26,19 @@ public:
 
 	const TSharedPtr<SBox>& GetVisibilityBox() const { return VisibilityBox; }
 
+	/** Releases the Slate resources of the slot's content, leaving the slot empty until the content is reloaded */
+	void UnloadContent();
+	void ReloadContent();
+	bool IsContentUnloaded() const { return bIsContentUnloaded; }
+
+	/** The last time (in platform seconds) the slot was the active one of its switcher */
+	double GetLastActiveTime() const { return LastActiveTime; }
+	void SetLastActiveTime(double InLastActiveTime) { LastActiveTime = InLastActiveTime; }
+
 private:
 
 	TSharedPtr<SBox> VisibilityBox;
+
+	double LastActiveTime = 0.;
+	bool bIsContentUnloaded = false;
 };
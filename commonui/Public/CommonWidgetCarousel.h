@@ -24,6 +24,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Carousel", meta=( UIMin=0, ClampMin=0 ))
 	int32 ActiveWidgetIndex;
 
+	/** If true, pages are only built once they're within NumCachedNeighbourPages of the current page, and released once they're beyond it */
+	UPROPERTY(EditAnywhere, Category="Carousel")
+	bool bGeneratePagesLazily = false;
+
+	/** The number of pages on either side of the current page to keep built when generating pages lazily */
+	UPROPERTY(EditAnywhere, Category="Carousel", meta=( EditCondition="bGeneratePagesLazily", UIMin=1, ClampMin=1 ))
+	int32 NumCachedNeighbourPages = 1;
+
 public:
 
 	/** Gets the slot index of the currently active widget */
@@ -42,6 +50,10 @@ public:
 	UFUNCTION( BlueprintCallable, Category = "Carousel" )
 	UWidget* GetWidgetAtIndex( int32 Index ) const;
 
+	/**
+	 * Scrolls to the next page every ScrollInterval seconds. Auto-scrolling is paused whenever the carousel isn't visible
+	 * or is within a deactivated activatable widget, and resumes with a full interval once it is again.
+	 */
 	UFUNCTION(BlueprintCallable, Category="Carousel")
 	void BeginAutoScrolling(float ScrollInterval = 10);
 
@@ -78,9 +90,14 @@ protected:
 	TSharedRef<SWidget> OnGenerateWidgetForCarousel(UPanelSlot* PanelSlot);
 	void HandlePageChanged(int32 PageIndex);
 
+	/** Builds the pages within the cached window around the given page and releases those beyond it */
+	void UpdateCachedPages(int32 PageIndex);
+	bool IsWithinCachedPages(int32 SlotIndex, int32 PageIndex) const;
+
 	// UPanelWidget
 	virtual UClass* GetSlotClass() const override;
 	virtual void OnSlotAdded(UPanelSlot* InSlot) override;
+	virtual void OnSlotRemoved(UPanelSlot* InSlot) override;
 	// End UPanelWidget
 
 	// UWidget interface
@@ -88,9 +105,15 @@ protected:
 	// End of UWidget interface
 
 protected:
-	FDelegateHandle TickerHandle;
+	float AutoScrollInterval = 0.f;
+	double NextAutoScrollTime = 0.;
 
 	TSharedPtr< SWidgetCarousel<UPanelSlot*> > MyCommonWidgetCarousel;
 
 	TArray< TSharedRef<SWidget> > CachedSlotWidgets;
+
+	/** The pages built so far when generating lazily. Entries are removed along with their slot. */
+	TMap< UPanelSlot*, TSharedRef<SWidget> > LazySlotWidgets;
+
+	friend class FCommonCarouselAutoScrollScheduler;
 };
@@ -8,7 +8,12 @@
 
 class UCommonUIActionRouterBase;
 class UCommonInputSubsystem;
+class UCommonUserWidget;
+class UCommonActivatableWidget;
+class UCommonButtonBase;
+class FCommonInteractableSpatialHash;
 class SWidget;
+class ITableRow;
 class UWidget;
 class UGameViewportClient;
 
@@ -33,6 +38,8 @@ public:
 		return NewCursor;
 	}
 
+	virtual ~FCommonAnalogCursor();
+
 	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override;
 	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override;
 	virtual bool HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override;
@@ -78,9 +85,22 @@ private:
 	
 	void RefreshCursorSettings();
 	void RefreshCursorVisibility();
+	bool ShouldShowCursor() const;
 	bool IsUsingGamepad() const;
 
 	void HandleInputMethodChanged(ECommonInputType NewInputMethod);
+	void HandleScrollRecipientsChanged(UCommonUserWidget& Widget);
+	void HandleActivationChanged(UCommonActivatableWidget& Widget);
+	void RefreshScrollRecipients();
+
+	/** Analog movement driven by the interactable spatial hash rather than hit-testing under the cursor every frame */
+	void TickAnalogMovement(const float DeltaTime, FSlateApplication& SlateApp, const TSharedRef<FSlateUser>& SlateUser);
+	void EnsureInteractableHash();
+	const UCommonButtonBase* FindPaintedButton(const UWidget* FoundWidget);
+	bool IsInteractableUnderCursor(FSlateApplication& SlateApp, const FSlateUser& SlateUser) const;
+	void HandleButtonConstructed(UCommonButtonBase& Button);
+	void HandleButtonDestructed(UCommonButtonBase& Button);
+	void HandleButtonPaintedRectChanged(const UCommonButtonBase& Button);
 
 	// Knowingly unorthodox member reference to a UObject - ok because we are a subobject of the owning router and will never outlive it
 	const UCommonUIActionRouterBase& ActionRouter;
@@ -91,6 +111,34 @@ private:
 	TWeakPtr<SWidget> LastCursorTarget;
 	FSlateRenderTransform LastCursorTargetTransform;
 
+	/** Tracked so the steady-state tick can tell when the cursor target or visibility need to be refreshed */
+	TWeakPtr<SWidget> LastFocusedWidget;
+	TWeakPtr<ITableRow> LastSelectedRow;
+	bool bIsCursorTargetDirty = true;
+	bool bIsCursorVisibilityDirty = true;
+	bool bIsCursorShown = false;
+
+	struct FAnalogScrollRecipient
+	{
+		TWeakObjectPtr<const UWidget> Widget;
+		bool bIsVertical = true;
+	};
+
+	/** The router's active scroll recipients, only gathered again once registrations or activation have changed */
+	TArray<FAnalogScrollRecipient> ScrollRecipients;
+	bool bScrollRecipientsDirty = true;
+
+	/**
+	 * Our player's constructed buttons. While the spatial hash is in use, a button's rect is only touched when it's painted
+	 * somewhere new. Lookups only trust buttons painted last frame and fall back to the hit test for everything else.
+	 */
+	TSet<TWeakObjectPtr<const UCommonButtonBase>> TrackedInteractables;
+	TUniquePtr<FCommonInteractableSpatialHash> InteractableHash;
+
+	/** Sub-pixel cursor position and speed for spatial hash movement */
+	FVector2D PreciseCursorPosition = FVector2D::ZeroVector;
+	float AnalogCursorSpeed = 0.f;
+
 	float TimeUntilScrollUpdate = 0.f;
 	ECommonInputType ActiveInputMethod;
 	bool bIsAnalogMovementEnabled = false;
@@ -30,6 +30,8 @@ protected:
 private:
 	void HandleBoundActionsUpdated(bool bFromOwningPlayer);
 	void HandleDeferredDisplayUpdate();
+	void GatherDisplayedBindings(const ULocalPlayer* LocalPlayer, TArray<FUIActionBindingHandle>& OutBindings) const;
+	void UpdateEntries(const TArray<FUIActionBindingHandle>& DisplayedBindings);
 	void HandlePlayerAdded(int32 PlayerIdx);
 	
 	void MonitorPlayerActions(const ULocalPlayer* NewPlayer);
@@ -16,6 +16,7 @@ class COMMONUI_API UCommonBoundActionButton : public UCommonButtonBase
 
 public:
 	void SetRepresentedAction(FUIActionBindingHandle InBindingHandle);
+	FUIActionBindingHandle GetRepresentedAction() const { return BindingHandle; }
 
 protected:
 	virtual void NativeOnClicked() override;
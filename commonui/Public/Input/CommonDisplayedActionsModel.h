@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "UIActionBindingHandle.h"
+#include "CommonDisplayedActionsModel.generated.h"
+
+class ULocalPlayer;
+class UCommonUIActionRouterBase;
+enum class ECommonInputType : uint8;
+
+/**
+ * The bound actions of a single local player that are eligible for display in an action bar, in display order.
+ *
+ * Gathering, filtering and sorting the player's bindings is done at most once per change to the player's bound actions
+ * and cached per input type and gamepad, so any number of action bars showing the same player's actions share the work.
+ */
+class COMMONUI_API FCommonDisplayedActionsModel : public TSharedFromThis<FCommonDisplayedActionsModel>
+{
+public:
+	/** @return The model for the given player, created on first request and kept until the player is removed. Null if the player has no action router. */
+	static TSharedPtr<FCommonDisplayedActionsModel> Get(const ULocalPlayer* LocalPlayer);
+
+	/** The displayed bindings for the player's current input type and gamepad */
+	const TArray<FUIActionBindingHandle>& GetDisplayedBindings();
+
+	/** Fires whenever the player's bound actions change, after which GetDisplayedBindings may return something different */
+	FSimpleMulticastDelegate& OnDisplayedActionsChanged() { return OnDisplayedActionsChangedEvent; }
+
+	FCommonDisplayedActionsModel(const UCommonUIActionRouterBase& InActionRouter);
+	~FCommonDisplayedActionsModel();
+
+private:
+	void HandleBoundActionsUpdated();
+	void GatherDisplayedBindings(ECommonInputType InputType, const FName& GamepadName, TArray<FUIActionBindingHandle>& OutBindings) const;
+
+	TWeakObjectPtr<const UCommonUIActionRouterBase> ActionRouter;
+	TMap<TPair<ECommonInputType, FName>, TArray<FUIActionBindingHandle>> CachedBindingsByInput;
+	FSimpleMulticastDelegate OnDisplayedActionsChangedEvent;
+};
+
+/** Owns the displayed actions model of its local player, so the model and its binding to the player's router go away with the player */
+UCLASS()
+class COMMONUI_API UCommonDisplayedActionsSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	TSharedPtr<FCommonDisplayedActionsModel> GetModel();
+
+private:
+	TSharedPtr<FCommonDisplayedActionsModel> Model;
+};
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Layout/SlateRect.h"
+
+class UWidget;
+
+/**
+ * Uniform grid over the absolute layout rects of interactable widgets.
+ *
+ * Lets the analog cursor find the interactable under it (or the nearest one around it) by looking in a cell or two,
+ * rather than hit-testing the whole window every frame. Rects are supplied by the owner (ex: as widgets are painted),
+ * and updating a widget whose rect hasn't changed is a no-op.
+ */
+class COMMONUI_API FCommonInteractableSpatialHash
+{
+public:
+	explicit FCommonInteractableSpatialHash(float InCellSize = 128.f);
+
+	/** Adds the widget at the given absolute rect, or moves it there if it's already tracked */
+	void UpdateWidget(const UWidget& Widget, const FSlateRect& AbsoluteRect);
+	void RemoveWidget(const UWidget& Widget);
+	void Reset();
+
+	int32 Num() const { return Entries.Num(); }
+
+	/** @return The smallest tracked widget containing the given absolute position */
+	const UWidget* FindWidgetAt(const FVector2D& AbsolutePosition) const;
+
+	/** @return The tracked widget with the closest edge to the given absolute position, if any is within MaxDistance */
+	const UWidget* FindNearestWidget(const FVector2D& AbsolutePosition, float MaxDistance) const;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<const UWidget> Widget;
+		FSlateRect Rect;
+		FIntRect CellBounds;
+	};
+
+	/** Inclusive range of cells overlapped by the rect */
+	FIntRect GetCellBounds(const FSlateRect& Rect) const;
+	FIntPoint GetCell(const FVector2D& Position) const;
+
+	void AddToCells(int32 EntryIndex, const FIntRect& CellBounds);
+	void RemoveFromCells(int32 EntryIndex, const FIntRect& CellBounds);
+
+	float CellSize;
+
+	TSparseArray<FEntry> Entries;
+	TMap<const UWidget*, int32> EntryIndicesByWidget;
+	TMap<FIntPoint, TArray<int32>> Cells;
+};